@@ -0,0 +1,313 @@
+#include "sortingAlgorithms.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+
+//every heap allocation goes through here so the peak bytes of one sort can be measured
+static std::atomic<size_t> currentBytes{0};
+static std::atomic<size_t> peakBytes{0};
+
+void* operator new(size_t size){
+    //the size is kept in front of the block so delete knows how much to give back
+    void* block = std::malloc(size + 16);
+    if(!block)
+        throw std::bad_alloc();
+    *static_cast<size_t*>(block) = size;
+    size_t now = currentBytes += size;
+    size_t peak = peakBytes;
+    while(now > peak && !peakBytes.compare_exchange_weak(peak, now));
+    return static_cast<char*>(block) + 16;
+}
+
+void operator delete(void* ptr) noexcept{
+    if(!ptr)
+        return;
+    void* block = static_cast<char*>(ptr) - 16;
+    currentBytes -= *static_cast<size_t*>(block);
+    std::free(block);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+/// @brief Float wrapper counting comparisons and element moves, a swap shows up as three moves
+struct Counted{
+    float value = 0;
+
+    static inline std::atomic<unsigned long long> comparisons{0};
+    static inline std::atomic<unsigned long long> moves{0};
+
+    Counted() = default;
+    Counted(float _value) : value(_value) {};
+    Counted(const Counted& other) : value(other.value) { moves.fetch_add(1, std::memory_order_relaxed); };
+    Counted& operator=(const Counted& other) { value = other.value; moves.fetch_add(1, std::memory_order_relaxed); return *this; };
+
+    bool operator<(const Counted& other) const { comparisons.fetch_add(1, std::memory_order_relaxed); return value < other.value; };
+    bool operator>(const Counted& other) const { comparisons.fetch_add(1, std::memory_order_relaxed); return value > other.value; };
+    bool operator<=(const Counted& other) const { comparisons.fetch_add(1, std::memory_order_relaxed); return value <= other.value; };
+    bool operator==(const Counted& other) const { comparisons.fetch_add(1, std::memory_order_relaxed); return value == other.value; };
+};
+
+/// @brief One sorting algorithm run by the benchmark
+struct Algorithm{
+    std::string name;
+    std::function<void(std::vector<float>&)> sort;
+    //null when the algorithm can not run on Counted
+    std::function<void(std::vector<Counted>&)> countedSort;
+    //largest size to run on, the O(N^2) sorts would take hours past it
+    size_t maxSize;
+    //largest size for inputs that are not uniform random, quickSort recurses N deep on them
+    size_t maxPresortedSize;
+};
+
+/// @brief Input generator, named like the CSV column
+struct Distribution{
+    std::string name;
+    std::function<std::vector<float>(size_t, std::mt19937&)> generate;
+};
+
+static std::vector<Algorithm> algorithms(){
+    const size_t all = ~size_t(0);
+    const size_t quadratic = 20000;
+    return {
+        {"bubbleSort", SortingAlgorithms<float>::bubbleSort, SortingAlgorithms<Counted>::bubbleSort, quadratic, quadratic},
+        {"insertionSort", SortingAlgorithms<float>::insertionSort, SortingAlgorithms<Counted>::insertionSort, quadratic, quadratic},
+        {"selectionSort", SortingAlgorithms<float>::selectionSort, SortingAlgorithms<Counted>::selectionSort, quadratic, quadratic},
+        {"mergeSort", SortingAlgorithms<float>::mergeSort, SortingAlgorithms<Counted>::mergeSort, all, all},
+        {"bottomUpMergeSort", [](std::vector<float>& vec){ SortingAlgorithms<float>::bottomUpMergeSort(vec); },
+                              [](std::vector<Counted>& vec){ SortingAlgorithms<Counted>::bottomUpMergeSort(vec); }, all, all},
+        {"powerSort", SortingAlgorithms<float>::powerSort, SortingAlgorithms<Counted>::powerSort, all, all},
+        {"quickSort", [](std::vector<float>& vec){ SortingAlgorithms<float>::quickSort(vec); },
+                      [](std::vector<Counted>& vec){ SortingAlgorithms<Counted>::quickSort(vec); }, all, 10000},
+        {"blockQuickSort", [](std::vector<float>& vec){ SortingAlgorithms<float>::quickSort(vec, PartitionScheme::Block); },
+                           [](std::vector<Counted>& vec){ SortingAlgorithms<Counted>::quickSort(vec, PartitionScheme::Block); }, all, 10000},
+        {"introSort", [](std::vector<float>& vec){ SortingAlgorithms<float>::introSort(vec); },
+                      [](std::vector<Counted>& vec){ SortingAlgorithms<Counted>::introSort(vec); }, all, all},
+        {"lomutoIntroSort", [](std::vector<float>& vec){ SortingAlgorithms<float>::introSort(vec, PartitionScheme::Lomuto); },
+                            [](std::vector<Counted>& vec){ SortingAlgorithms<Counted>::introSort(vec, PartitionScheme::Lomuto); }, all, all},
+        {"heapSort", SortingAlgorithms<float>::heapSort, SortingAlgorithms<Counted>::heapSort, all, all},
+        {"radixSort", SortingAlgorithms<float>::radixSort, nullptr, all, all},
+        {"parallelQuickSort", [](std::vector<float>& vec){ SortingAlgorithms<float>::parallelQuickSort(vec); },
+                              [](std::vector<Counted>& vec){ SortingAlgorithms<Counted>::parallelQuickSort(vec); }, all, all},
+        {"parallelMergeSort", [](std::vector<float>& vec){ SortingAlgorithms<float>::parallelMergeSort(vec); },
+                              [](std::vector<Counted>& vec){ SortingAlgorithms<Counted>::parallelMergeSort(vec); }, all, all},
+        {"parallelSampleSort", [](std::vector<float>& vec){ SortingAlgorithms<float>::parallelSampleSort(vec); },
+                               [](std::vector<Counted>& vec){ SortingAlgorithms<Counted>::parallelSampleSort(vec); }, all, all},
+    };
+}
+
+static std::vector<Distribution> distributions(){
+    return {
+        {"uniform", [](size_t n, std::mt19937& rng){
+            std::uniform_real_distribution<float> dist(0.f, 1e6f);
+            std::vector<float> vec(n);
+            for(float& value : vec)
+                value = dist(rng);
+            return vec;
+        }},
+        {"sorted", [](size_t n, std::mt19937&){
+            std::vector<float> vec(n);
+            for(size_t i = 0; i < n; i++)
+                vec[i] = i;
+            return vec;
+        }},
+        {"reverse", [](size_t n, std::mt19937&){
+            std::vector<float> vec(n);
+            for(size_t i = 0; i < n; i++)
+                vec[i] = n - i;
+            return vec;
+        }},
+        {"fewUnique", [](size_t n, std::mt19937& rng){
+            std::uniform_int_distribution<int> dist(0, 15);
+            std::vector<float> vec(n);
+            for(float& value : vec)
+                value = dist(rng);
+            return vec;
+        }},
+        {"organPipe", [](size_t n, std::mt19937&){
+            std::vector<float> vec(n);
+            for(size_t i = 0; i < n; i++)
+                vec[i] = i < n / 2 ? i : n - i;
+            return vec;
+        }},
+        {"nearlySorted", [](size_t n, std::mt19937& rng){
+            //sorted with 1% of the elements swapped to random places
+            std::vector<float> vec(n);
+            for(size_t i = 0; i < n; i++)
+                vec[i] = i;
+            std::uniform_int_distribution<size_t> dist(0, n - 1);
+            for(size_t i = 0; i < n / 100; i++)
+                std::swap(vec[dist(rng)], vec[dist(rng)]);
+            return vec;
+        }},
+        {"zipf", [](size_t n, std::mt19937& rng){
+            //rank r of 10000 values is drawn with probability proportional to 1/r
+            const size_t ranks = 10000;
+            std::vector<double> cdf(ranks);
+            double total = 0;
+            for(size_t r = 0; r < ranks; r++){
+                total += 1.0 / (r + 1);
+                cdf[r] = total;
+            }
+            std::uniform_real_distribution<double> dist(0, total);
+            std::vector<float> vec(n);
+            for(float& value : vec)
+                value = std::lower_bound(cdf.begin(), cdf.end(), dist(rng)) - cdf.begin();
+            return vec;
+        }},
+    };
+}
+
+static bool isSorted(const std::vector<Counted>& vec){
+    for(size_t i = 1; i < vec.size(); i++){
+        if(vec[i].value < vec[i-1].value)
+            return false;
+    }
+    return true;
+}
+
+static bool isSorted(const std::vector<float>& vec){
+    for(size_t i = 1; i < vec.size(); i++){
+        if(vec[i] < vec[i-1])
+            return false;
+    }
+    return true;
+}
+
+/// @brief Times the parallel sorts at 1, 2, 4... threads on uniform input against the serial quickSort
+static int scaling(size_t size, unsigned int maxThreads, const std::string& csvPath){
+    std::mt19937 rng(12345);
+    std::vector<float> input = distributions()[0].generate(size, rng);
+    auto time = [&input](const std::function<void(std::vector<float>&)>& sort){
+        std::vector<float> vec = input;
+        auto start = std::chrono::steady_clock::now();
+        sort(vec);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if(!isSorted(vec))
+            ms = -1;
+        return ms;
+    };
+
+    double baseline = time([](std::vector<float>& vec){ SortingAlgorithms<float>::quickSort(vec); });
+    std::ofstream csv(csvPath);
+    csv << "algorithm,threads,size,ms,speedup\n";
+    csv << "quickSort,1," << size << "," << baseline << ",1\n";
+    std::printf("quickSort on %zu elements: %.1f ms, hardware threads: %u\n\n", size, baseline, std::thread::hardware_concurrency());
+    std::cout << "threads  parallelSampleSort        parallelQuickSort\n";
+
+    for(unsigned int threads = 1; threads <= maxThreads; threads *= 2){
+        //one pool per thread count, so starting threads is not part of any timed run
+        ThreadPool pool(threads);
+        double sample = time([&pool](std::vector<float>& vec){ SortingAlgorithms<float>::parallelSampleSort(vec, pool); });
+        double quick = time([&pool](std::vector<float>& vec){ SortingAlgorithms<float>::parallelQuickSort(vec, pool); });
+        if(sample < 0 || quick < 0){
+            std::cerr << "parallel sort did not sort at " << threads << " threads\n";
+            return 1;
+        }
+        csv << "parallelSampleSort," << threads << "," << size << "," << sample << "," << baseline / sample << "\n";
+        csv << "parallelQuickSort," << threads << "," << size << "," << quick << "," << baseline / quick << "\n";
+        std::printf("%-8u %8.1f ms %6.2fx       %8.1f ms %6.2fx\n", threads, sample, baseline / sample, quick, baseline / quick);
+    }
+    std::cout << "\nwrote " << csvPath << "\n";
+    return 0;
+}
+
+int main(int argc, char** argv){
+    size_t minSize = 1000;
+    //the full sweep goes to 1e8 with --max 1e8, that needs over a gigabyte and several seconds for every sort of every
+    //distribution, so a plain run stops at 1e6
+    size_t maxSize = 1000000;
+    size_t maxCountedSize = 1000000;
+    std::string csvPath = "benchmark.csv";
+    std::string only;
+    unsigned int scalingThreads = 0;
+    for(int i = 1; i + 1 < argc; i += 2){
+        std::string arg = argv[i];
+        if(arg == "--min")
+            minSize = std::stod(argv[i+1]);
+        else if(arg == "--max")
+            maxSize = std::stod(argv[i+1]);
+        else if(arg == "--max-counted")
+            maxCountedSize = std::stod(argv[i+1]);
+        else if(arg == "--csv")
+            csvPath = argv[i+1];
+        else if(arg == "--only")
+            only = argv[i+1];
+        else if(arg == "--scaling")
+            scalingThreads = std::stoul(argv[i+1]);
+        else{
+            std::cerr << "usage: " << argv[0] << " [--min N] [--max N] [--max-counted N] [--csv path] [--only algorithm] [--scaling maxThreads]\n"
+                      << "  sizes go in powers of ten from --min (default 1e3) to --max (default 1e6, --max 1e8 for the full range)\n"
+                      << "  --max-counted caps the counted runs (default 1e6), --scaling sorts --max elements at 1, 2, 4... threads\n";
+            return 1;
+        }
+    }
+    if(scalingThreads > 0)
+        return scaling(maxSize, scalingThreads, csvPath);
+
+    std::ofstream csv(csvPath);
+    csv << "algorithm,distribution,size,ns_per_element,comparisons,moves,peak_bytes\n";
+    std::cout << "algorithm            distribution  size        ns/elem     comparisons   moves         peak bytes\n";
+
+    std::mt19937 rng(12345);
+    for(const Distribution& distribution : distributions()){
+        for(size_t size = minSize; size <= maxSize; size *= 10){
+            std::vector<float> input = distribution.generate(size, rng);
+            for(const Algorithm& algorithm : algorithms()){
+                if(!only.empty() && algorithm.name != only)
+                    continue;
+                if(size > (distribution.name == "uniform" ? algorithm.maxSize : algorithm.maxPresortedSize))
+                    continue;
+
+                //small sizes are repeated and the fastest run kept to cut timer noise
+                int reps = size <= 10000 ? 5 : 1;
+                double best = 1e300;
+                size_t peak = 0;
+                for(int rep = 0; rep < reps; rep++){
+                    std::vector<float> vec = input;
+                    size_t baseline = currentBytes;
+                    peakBytes = baseline;
+                    auto start = std::chrono::steady_clock::now();
+                    algorithm.sort(vec);
+                    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                    best = std::min(best, ns);
+                    peak = peakBytes - baseline;
+                    if(!isSorted(vec)){
+                        std::cerr << algorithm.name << " did not sort " << distribution.name << "\n";
+                        return 1;
+                    }
+                }
+
+                std::string comparisons = "NA";
+                std::string moves = "NA";
+                if(algorithm.countedSort && size <= maxCountedSize){
+                    std::vector<Counted> vec(input.begin(), input.end());
+                    Counted::comparisons = 0;
+                    Counted::moves = 0;
+                    algorithm.countedSort(vec);
+                    comparisons = std::to_string(Counted::comparisons);
+                    moves = std::to_string(Counted::moves);
+                    if(!isSorted(vec)){
+                        std::cerr << algorithm.name << " did not sort " << distribution.name << "\n";
+                        return 1;
+                    }
+                }
+
+                double perElement = best / size;
+                csv << algorithm.name << "," << distribution.name << "," << size << "," << perElement << ","
+                    << comparisons << "," << moves << "," << peak << "\n";
+                std::printf("%-20s %-13s %-11zu %-11.2f %-13s %-13s %zu\n", algorithm.name.c_str(), distribution.name.c_str(),
+                            size, perElement, comparisons.c_str(), moves.c_str(), peak);
+            }
+        }
+    }
+    std::cout << "\nwrote " << csvPath << "\n";
+    return 0;
+}
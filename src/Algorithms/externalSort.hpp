@@ -0,0 +1,301 @@
+#ifndef EXTERNAL_SORT
+#define EXTERNAL_SORT
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "kWayMerge.hpp"
+#include "sortingAlgorithms.hpp"
+
+/// @brief What an external sort did and how fast it went
+struct ExternalSortStats{
+    size_t bytes = 0;
+    unsigned int runs = 0;
+    unsigned int mergePasses = 0;
+    double seconds = 0;
+    double mbPerSecond = 0;
+};
+
+/// @brief Sorts binary files of fixed size records that do not fit in memory
+/// Memory sized chunks are sorted with introSort into temporary run files, which are then k-way merged with a loser tree
+/// @tparam T Record type, has to be trivially copyable since it is read and written as raw bytes
+template <typename T>
+class ExternalSort{
+    public:
+
+        /// @brief Sorts the records of input into output
+        /// @param input Binary file of T records
+        /// @param output File to write the sorted records to, can be the same as input
+        /// @param memoryBudget Bytes of records held in memory at once, used for chunks and merge buffers
+        /// @param tempDir Directory for the run files, empty uses the system temp directory
+        /// @return Returns the sizes and throughput of the sort
+        static ExternalSortStats sort(const std::string& input, const std::string& output,
+                                      size_t memoryBudget = size_t(256) << 20, const std::string& tempDir = "");
+
+    private:
+        /// @brief Smallest read buffer given to a run while merging, bounds the merge fan in
+        static constexpr size_t minBufferBytes = 64 << 10;
+
+        /// @brief Deletes every temporary file it was given when it goes out of scope, so a sort that throws
+        /// does not leave its runs behind
+        class TempFiles{
+            public:
+                TempFiles() {};
+
+                ~TempFiles();
+
+                TempFiles(const TempFiles&) = delete;
+                TempFiles& operator=(const TempFiles&) = delete;
+
+                /// @brief Makes a new unique path inside dir and takes ownership of the file it will name
+                std::string create(const std::filesystem::path& dir);
+
+            private:
+                std::vector<std::string> paths;
+        };
+
+        /// @brief Buffered sequential reader over a run file
+        class RunReader{
+            public:
+                RunReader(const std::string& path, size_t bufferRecords);
+
+                /// @brief Checks if every record was consumed
+                bool done() { return pos == count; };
+
+                /// @brief Gets the current record
+                T& current() { return buffer[pos]; };
+
+                /// @brief Moves to the next record, refilling the buffer from the file when needed
+                void next();
+
+            private:
+                std::string path;
+                std::ifstream file;
+                std::vector<T> buffer;
+                size_t pos = 0;
+                size_t count = 0;
+
+                /// @brief Reads the next buffer, throws std::runtime_error on a read error or a partial record
+                void refill();
+        };
+
+        /// @brief Buffered sequential writer
+        class RunWriter{
+            public:
+                RunWriter(const std::string& path, size_t bufferRecords);
+
+                void write(const T& record);
+
+                /// @brief Writes the buffered records, throws std::runtime_error if the write fails
+                void flush();
+
+                /// @brief Flushes and closes the file, throws std::runtime_error if any of it fails
+                /// A writer destroyed without close was abandoned by an exception and writes nothing more
+                void close();
+
+            private:
+                std::string path;
+                std::ofstream file;
+                std::vector<T> buffer;
+        };
+
+        /// @brief Sorts memoryBudget sized chunks of input into run files
+        static std::vector<std::string> createRuns(const std::string& input, size_t memoryBudget,
+                                                   const std::filesystem::path& dir, TempFiles& temps, ExternalSortStats& stats);
+
+        /// @brief K-way merges the runs into output
+        static void mergeRuns(const std::vector<std::string>& runs, const std::string& output, size_t memoryBudget);
+};
+
+template <typename T>
+ExternalSortStats ExternalSort<T>::sort(const std::string& input, const std::string& output,
+                                        size_t memoryBudget, const std::string& tempDir){
+    static_assert(std::is_trivially_copyable_v<T>, "ExternalSort reads and writes records as raw bytes");
+    if(memoryBudget < 2 * minBufferBytes)
+        throw std::invalid_argument("Memory budget is too small");
+
+    auto start = std::chrono::steady_clock::now();
+    std::filesystem::path dir = tempDir.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(tempDir);
+    ExternalSortStats stats;
+    TempFiles temps;
+
+    std::vector<std::string> runs = createRuns(input, memoryBudget, dir, temps, stats);
+    stats.runs = runs.size();
+
+    //merge groups of runs until one merge is enough, each run needs at least minBufferBytes to read into
+    size_t maxFanIn = std::max<size_t>(2, memoryBudget / minBufferBytes - 1);
+    while(runs.size() > maxFanIn){
+        std::vector<std::string> merged;
+        for(size_t begin = 0; begin < runs.size(); begin += maxFanIn){
+            std::vector<std::string> group(runs.begin() + begin, runs.begin() + std::min(begin + maxFanIn, runs.size()));
+            std::string path = temps.create(dir);
+            mergeRuns(group, path, memoryBudget);
+            for(const std::string& run : group)
+                std::filesystem::remove(run);
+            merged.push_back(path);
+        }
+        runs.swap(merged);
+        stats.mergePasses++;
+    }
+
+    mergeRuns(runs, output, memoryBudget);
+    stats.mergePasses++;
+    for(const std::string& run : runs)
+        std::filesystem::remove(run);
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.mbPerSecond = stats.seconds > 0 ? stats.bytes / stats.seconds / 1e6 : 0;
+    return stats;
+}
+
+template <typename T>
+std::vector<std::string> ExternalSort<T>::createRuns(const std::string& input, size_t memoryBudget,
+                                                     const std::filesystem::path& dir, TempFiles& temps, ExternalSortStats& stats){
+    std::ifstream file(input, std::ios::binary);
+    if(!file)
+        throw std::runtime_error("Could not open " + input);
+
+    std::vector<std::string> runs;
+    size_t chunkRecords = std::max<size_t>(1, memoryBudget / sizeof(T));
+    std::vector<T> chunk;
+    while(true){
+        chunk.resize(chunkRecords);
+        file.read(reinterpret_cast<char*>(chunk.data()), chunkRecords * sizeof(T));
+        size_t bytes = file.gcount();
+        if(file.bad())
+            throw std::runtime_error("Could not read " + input);
+        if(bytes % sizeof(T) != 0)
+            throw std::runtime_error(input + " is not a whole number of records");
+        if(bytes == 0)
+            break;
+        stats.bytes += bytes;
+
+        chunk.resize(bytes / sizeof(T));
+        SortingAlgorithms<T>::introSort(chunk);
+
+        std::string path = temps.create(dir);
+        std::ofstream run(path, std::ios::binary);
+        run.write(reinterpret_cast<const char*>(chunk.data()), bytes);
+        //a full disk can show up at any of these, not only in the write
+        run.flush();
+        run.close();
+        if(!run)
+            throw std::runtime_error("Could not write " + path);
+        runs.push_back(path);
+
+        if(chunk.size() < chunkRecords) //short read was the end of the file
+            break;
+    }
+    return runs;
+}
+
+template <typename T>
+void ExternalSort<T>::mergeRuns(const std::vector<std::string>& runs, const std::string& output, size_t memoryBudget){
+    //the budget is split evenly between the run readers and the output writer
+    size_t bufferRecords = std::max<size_t>(1, memoryBudget / (runs.size() + 1) / sizeof(T));
+
+    std::vector<RunReader> readers;
+    readers.reserve(runs.size());
+    for(const std::string& run : runs)
+        readers.emplace_back(run, bufferRecords);
+    RunWriter writer(output, bufferRecords);
+
+    //loser tree over the current record of every run, ties go to the earlier run
+    LoserTree<T> tree(readers.size());
+    for(unsigned int i = 0; i < readers.size(); i++){
+        tree.set(i, readers[i].done() ? nullptr : &readers[i].current());
+    }
+    tree.build();
+
+    while(!tree.empty()){
+        unsigned int run = tree.winner();
+        writer.write(readers[run].current());
+        readers[run].next();
+        tree.replace(readers[run].done() ? nullptr : &readers[run].current());
+    }
+    writer.close();
+}
+
+template <typename T>
+ExternalSort<T>::TempFiles::~TempFiles(){
+    //runs already merged were removed early, a missing file is not an error here
+    std::error_code error;
+    for(const std::string& path : paths)
+        std::filesystem::remove(path, error);
+}
+
+template <typename T>
+std::string ExternalSort<T>::TempFiles::create(const std::filesystem::path& dir){
+    static std::atomic<unsigned long> counter{0};
+    unsigned long stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    paths.push_back((dir / ("extsort_" + std::to_string(stamp) + "_" + std::to_string(counter++) + ".run")).string());
+    return paths.back();
+}
+
+template <typename T>
+ExternalSort<T>::RunReader::RunReader(const std::string& _path, size_t bufferRecords)
+    : path(_path), file(_path, std::ios::binary), buffer(bufferRecords){
+    if(!file)
+        throw std::runtime_error("Could not open " + path);
+    refill();
+}
+
+template <typename T>
+void ExternalSort<T>::RunReader::next(){
+    pos++;
+    if(pos == count)
+        refill();
+}
+
+template <typename T>
+void ExternalSort<T>::RunReader::refill(){
+    file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(T));
+    //eof and fail are set by a short read at the end, only bad means the read itself went wrong
+    if(file.bad())
+        throw std::runtime_error("Could not read " + path);
+    size_t bytes = file.gcount();
+    if(bytes % sizeof(T) != 0)
+        throw std::runtime_error(path + " ends in a partial record");
+    count = bytes / sizeof(T);
+    pos = 0;
+}
+
+template <typename T>
+ExternalSort<T>::RunWriter::RunWriter(const std::string& _path, size_t bufferRecords)
+    : path(_path), file(_path, std::ios::binary | std::ios::trunc){
+    if(!file)
+        throw std::runtime_error("Could not open " + path);
+    buffer.reserve(bufferRecords);
+}
+
+template <typename T>
+void ExternalSort<T>::RunWriter::write(const T& record){
+    buffer.push_back(record);
+    if(buffer.size() == buffer.capacity())
+        flush();
+}
+
+template <typename T>
+void ExternalSort<T>::RunWriter::flush(){
+    file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(T));
+    buffer.clear();
+    if(!file)
+        throw std::runtime_error("Could not write " + path);
+}
+
+template <typename T>
+void ExternalSort<T>::RunWriter::close(){
+    flush();
+    file.flush();
+    file.close();
+    if(!file)
+        throw std::runtime_error("Could not write " + path);
+}
+
+#endif
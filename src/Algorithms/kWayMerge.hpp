@@ -0,0 +1,311 @@
+#ifndef K_WAY_MERGE
+#define K_WAY_MERGE
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "threadPool.hpp"
+
+/// @brief Tournament tree of losers over k sorted sources, finds the next smallest head in Log2(k) comparisons
+/// Every internal node keeps the loser of the match played there so replaying a leaf only walks up its own path
+/// @tparam T Type of the elements, compared with <
+template <typename T>
+class LoserTree{
+    public:
+
+        /// @brief Makes a tree for k sources, every head starts out exhausted
+        explicit LoserTree(unsigned int k);
+
+        /// @brief Sets the current head of a source before build, nullptr marks it exhausted
+        void set(unsigned int source, const T* head);
+
+        /// @brief Plays every match once the heads are set, O(k)
+        void build();
+
+        /// @brief Checks if every source is exhausted
+        bool empty() { return heads[tree[0]] == nullptr; };
+
+        /// @brief Gets the source holding the smallest head, ties go to the lower source index
+        unsigned int winner() { return tree[0]; };
+
+        /// @brief Gets the smallest head
+        const T& top() { return *heads[tree[0]]; };
+
+        /// @brief Replaces the head of the winner and replays its path to the root
+        /// @param head Next element of the winner, nullptr if it ran out
+        void replace(const T* head);
+
+    private:
+        unsigned int k;
+        std::vector<const T*> heads;
+        //tree[0] is the overall winner and tree[1, k) the losers, leaf i is node k+i
+        std::vector<unsigned int> tree;
+
+        /// @brief Checks if source a comes out before source b, exhausted sources lose to everything
+        bool beats(unsigned int a, unsigned int b);
+};
+
+/// @brief Merges already sorted ranges, such as one shard per worker, without sorting them again
+/// @tparam T Type of the elements, compared with <
+template <typename T>
+class KWayMerge{
+    public:
+
+        /// @brief Sorted input [begin, end)
+        struct Range{
+            const T* begin;
+            const T* end;
+        };
+
+        /// @brief Stable k-way merge with a loser tree, O(N*Log(k)) time, equal elements keep the order of their runs
+        /// @param output Resized to the total size if smaller, the merged elements go to its front
+        static inline void merge(const std::vector<std::vector<T>>& runs, std::vector<T>& output);
+
+        /// @brief Merges the ranges into output, which has room for all of them and does not overlap them
+        static inline void merge(const std::vector<Range>& ranges, T* output);
+
+        /// @brief Splits the output into even chunks with merge path co-ranking and merges the chunks on a thread pool
+        /// The result is the same as merge
+        /// @param threads Number of threads to use, 0 runs on ThreadPool::shared() instead of starting a pool
+        /// @param grain Outputs smaller than this are not split further
+        static inline void parallelMerge(const std::vector<std::vector<T>>& runs, std::vector<T>& output,
+                                         unsigned int threads = 0, size_t grain = 1 << 16);
+
+        /// @brief Parallel merge on a pool the caller keeps, so repeated merges do not start and join threads
+        static inline void parallelMerge(const std::vector<std::vector<T>>& runs, std::vector<T>& output,
+                                         ThreadPool& pool, size_t grain = 1 << 16);
+
+        /// @brief Parallel merge of the ranges into output, which has room for all of them and does not overlap them
+        static inline void parallelMerge(const std::vector<Range>& ranges, T* output,
+                                         unsigned int threads = 0, size_t grain = 1 << 16);
+
+        /// @brief Parallel merge of the ranges on a pool the caller keeps
+        static inline void parallelMerge(const std::vector<Range>& ranges, T* output, ThreadPool& pool,
+                                         size_t grain = 1 << 16);
+
+    private:
+        /// @brief Gets the ranges of a list of vectors and checks output is big enough
+        static std::vector<Range> toRanges(const std::vector<std::vector<T>>& runs, std::vector<T>& output);
+
+        /// @brief Multi sequence selection, finds how many elements of every range go before output index rank
+        /// Elements are ordered by value, then range index, then position, the same order merge writes them in
+        /// @return Returns one split per range, they add up to rank
+        static std::vector<size_t> coRank(const std::vector<Range>& ranges, size_t rank);
+};
+
+template <typename T>
+LoserTree<T>::LoserTree(unsigned int _k) : k(std::max(1u, _k)), heads(k, nullptr), tree(k, 0) {}
+
+template <typename T>
+void LoserTree<T>::set(unsigned int source, const T* head){
+    if(source >= k)
+        throw std::out_of_range("Invalid source");
+    heads[source] = head;
+}
+
+template <typename T>
+bool LoserTree<T>::beats(unsigned int a, unsigned int b){
+    if(heads[a] == nullptr)
+        return false;
+    if(heads[b] == nullptr)
+        return true;
+    //both comparisons are made so the result is computed without a data dependent branch
+    bool less = *heads[a] < *heads[b];
+    bool greater = *heads[b] < *heads[a];
+    return less | (!greater & (a < b));
+}
+
+template <typename T>
+void LoserTree<T>::build(){
+    //winners of the subtrees, only needed while building
+    std::vector<unsigned int> winners(2 * k);
+    for(unsigned int i = 0; i < k; i++)
+        winners[k + i] = i;
+    for(unsigned int node = k - 1; node >= 1; node--){
+        unsigned int left = winners[2 * node];
+        unsigned int right = winners[2 * node + 1];
+        if(beats(left, right)){
+            winners[node] = left;
+            tree[node] = right;
+        }
+        else{
+            winners[node] = right;
+            tree[node] = left;
+        }
+    }
+    tree[0] = k > 1 ? winners[1] : 0;
+}
+
+template <typename T>
+void LoserTree<T>::replace(const T* head){
+    unsigned int source = tree[0];
+    heads[source] = head;
+    //the new head only has to beat the losers on its way up, the rest of the tree is unchanged
+    unsigned int winner = source;
+    for(unsigned int node = (k + source) / 2; node >= 1; node /= 2){
+        //selects instead of a swap in a branch, random data would mispredict every other level
+        unsigned int loser = tree[node];
+        bool swap = beats(loser, winner);
+        tree[node] = swap ? winner : loser;
+        winner = swap ? loser : winner;
+    }
+    tree[0] = winner;
+}
+
+template <typename T>
+void KWayMerge<T>::merge(const std::vector<std::vector<T>>& runs, std::vector<T>& output){
+    std::vector<Range> ranges = toRanges(runs, output);
+    merge(ranges, output.data());
+}
+
+template <typename T>
+void KWayMerge<T>::merge(const std::vector<Range>& ranges, T* output){
+    if(ranges.empty())
+        return;
+    if(ranges.size() == 1){
+        std::copy(ranges[0].begin, ranges[0].end, output);
+        return;
+    }
+
+    std::vector<Range> curr = ranges;
+    LoserTree<T> tree(curr.size());
+    for(unsigned int i = 0; i < curr.size(); i++){
+        tree.set(i, curr[i].begin != curr[i].end ? curr[i].begin : nullptr);
+    }
+    tree.build();
+
+    while(!tree.empty()){
+        unsigned int run = tree.winner();
+        *output++ = *curr[run].begin++;
+        tree.replace(curr[run].begin != curr[run].end ? curr[run].begin : nullptr);
+    }
+}
+
+template <typename T>
+void KWayMerge<T>::parallelMerge(const std::vector<std::vector<T>>& runs, std::vector<T>& output, unsigned int threads, size_t grain){
+    std::vector<Range> ranges = toRanges(runs, output);
+    parallelMerge(ranges, output.data(), threads, grain);
+}
+
+template <typename T>
+void KWayMerge<T>::parallelMerge(const std::vector<std::vector<T>>& runs, std::vector<T>& output, ThreadPool& pool, size_t grain){
+    std::vector<Range> ranges = toRanges(runs, output);
+    parallelMerge(ranges, output.data(), pool, grain);
+}
+
+template <typename T>
+void KWayMerge<T>::parallelMerge(const std::vector<Range>& ranges, T* output, unsigned int threads, size_t grain){
+    if(threads == 0){
+        parallelMerge(ranges, output, ThreadPool::shared(), grain);
+        return;
+    }
+    ThreadPool pool(threads);
+    parallelMerge(ranges, output, pool, grain);
+}
+
+template <typename T>
+void KWayMerge<T>::parallelMerge(const std::vector<Range>& ranges, T* output, ThreadPool& pool, size_t grain){
+    size_t total = 0;
+    for(const Range& range : ranges)
+        total += range.end - range.begin;
+
+    //a few chunks per thread so a slow one does not hold up the rest
+    size_t chunks = std::min<size_t>(pool.size() * 4, total / std::max<size_t>(grain, 1));
+    if(chunks < 2){
+        merge(ranges, output);
+        return;
+    }
+
+    std::vector<std::vector<size_t>> splits(chunks + 1);
+    {
+        TaskGroup group(pool);
+        for(size_t c = 0; c <= chunks; c++){
+            group.run([&, c]{
+                splits[c] = coRank(ranges, total * c / chunks);
+            });
+        }
+        group.wait();
+    }
+
+    TaskGroup group(pool);
+    for(size_t c = 0; c < chunks; c++){
+        group.run([&, c]{
+            std::vector<Range> parts(ranges.size());
+            for(size_t i = 0; i < ranges.size(); i++){
+                parts[i] = {ranges[i].begin + splits[c][i], ranges[i].begin + splits[c + 1][i]};
+            }
+            merge(parts, output + total * c / chunks);
+        });
+    }
+    group.wait();
+}
+
+template <typename T>
+std::vector<typename KWayMerge<T>::Range> KWayMerge<T>::toRanges(const std::vector<std::vector<T>>& runs, std::vector<T>& output){
+    std::vector<Range> ranges;
+    ranges.reserve(runs.size());
+    size_t total = 0;
+    for(const std::vector<T>& run : runs){
+        ranges.push_back({run.data(), run.data() + run.size()});
+        total += run.size();
+    }
+    if(output.size() < total)
+        output.resize(total);
+    return ranges;
+}
+
+template <typename T>
+std::vector<size_t> KWayMerge<T>::coRank(const std::vector<Range>& ranges, size_t rank){
+    size_t k = ranges.size();
+    //split i is known to be in [low[i], high[i]]
+    std::vector<size_t> low(k, 0);
+    std::vector<size_t> high(k);
+    for(size_t i = 0; i < k; i++)
+        high[i] = ranges[i].end - ranges[i].begin;
+
+    std::vector<size_t> before(k);
+    while(true){
+        //probe the middle of the widest window so the number of rounds stays about k*Log(N)
+        size_t probe = k;
+        size_t widest = 0;
+        for(size_t i = 0; i < k; i++){
+            if(high[i] - low[i] > widest){
+                widest = high[i] - low[i];
+                probe = i;
+            }
+        }
+        if(probe == k)
+            return low;
+
+        size_t mid = low[probe] + (high[probe] - low[probe]) / 2;
+        const T& value = ranges[probe].begin[mid];
+
+        //count what comes before the probe, equal elements of earlier ranges go first
+        size_t count = 0;
+        for(size_t i = 0; i < k; i++){
+            const T* begin = ranges[i].begin + low[i];
+            const T* end = ranges[i].begin + high[i];
+            if(i == probe)
+                before[i] = mid;
+            else if(i < probe)
+                before[i] = std::upper_bound(begin, end, value) - ranges[i].begin;
+            else
+                before[i] = std::lower_bound(begin, end, value) - ranges[i].begin;
+            count += before[i];
+        }
+
+        if(count < rank){
+            //the probe and everything before it is inside the first rank elements
+            for(size_t i = 0; i < k; i++)
+                low[i] = std::max(low[i], before[i]);
+            low[probe] = mid + 1;
+        }
+        else{
+            for(size_t i = 0; i < k; i++)
+                high[i] = std::min(high[i], before[i]);
+            high[probe] = mid;
+        }
+    }
+}
+
+#endif
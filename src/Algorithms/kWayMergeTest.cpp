@@ -0,0 +1,28 @@
+#include "kWayMerge.hpp"
+#include "../check.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+int main(){
+    //the parallel merge on a kept pool, on the shared pool and the serial merge all give the same output
+    ThreadPool pool(2);
+    std::mt19937 rng(3);
+    for(int round = 0; round < 3; round++){
+        std::vector<std::vector<int>> runs(5 + round);
+        for(std::vector<int>& run : runs){
+            run.resize(rng() % 20000);
+            for(int& value : run)
+                value = rng() % 500;
+            std::sort(run.begin(), run.end());
+        }
+        std::vector<int> serial, kept, shared;
+        KWayMerge<int>::merge(runs, serial);
+        KWayMerge<int>::parallelMerge(runs, kept, pool, 1000);
+        KWayMerge<int>::parallelMerge(runs, shared, 0, 1000);
+        check::that(std::is_sorted(serial.begin(), serial.end()), "merge sorts");
+        check::that(kept == serial, "parallelMerge on a kept pool matches merge");
+        check::that(shared == serial, "parallelMerge on the shared pool matches merge");
+    }
+    return check::failures();
+}
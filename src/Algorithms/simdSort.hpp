@@ -0,0 +1,249 @@
+#ifndef SIMD_SORT
+#define SIMD_SORT
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+/// @brief Bitonic sorting networks on 256 bit vectors for sorting up to 64 elements without branches
+/// The AVX2 or SSE4.2 build of the kernel is picked at runtime from the CPU features, with a scalar fallback
+/// @tparam T float, double or a 32/64 bit integer
+template <typename T>
+class SimdSortingNetwork{
+    public:
+
+        /// @brief True if T has a vector kernel
+        static constexpr bool supported = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                                          (std::is_integral_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+
+        /// @brief Largest range the kernel sorts
+        static constexpr unsigned int maxSize = 64;
+
+        /// @brief Sorts data[0, n) in place, n has to be at most maxSize, NaNs end up last in no particular order
+        static void sort(T* data, unsigned int n);
+
+    private:
+        using Lane = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+
+        static constexpr unsigned int lanes = 32 / sizeof(Lane);
+        //unsupported types still need a valid vector type to instantiate the class
+        using Element = std::conditional_t<supported, T, Lane>;
+        typedef Element Vector __attribute__((vector_size(32)));
+        typedef Lane Index __attribute__((vector_size(32)));
+
+        using Kernel = void (*)(T*, unsigned int);
+
+        /// @brief Picks the best kernel the CPU runs, called once
+        static Kernel selectKernel();
+
+        static void sortScalar(T* data, unsigned int n);
+
+        /// @brief Moves every NaN behind the other values
+        /// @return Returns the number of values that are not NaN
+        static unsigned int moveNansBack(T* data, unsigned int n);
+
+#if defined(__x86_64__) || defined(__i386__)
+        [[gnu::target("avx2")]] static void sortAvx2(T* data, unsigned int n);
+
+        [[gnu::target("sse4.2")]] static void sortSse4(T* data, unsigned int n);
+#endif
+
+        /// @brief Pads to the next power of two and runs the matching network, inlined into every kernel
+        [[gnu::always_inline]] static inline void sortPadded(T* data, unsigned int n);
+
+        /// @brief Bitonic sort of Width elements held in Width/lanes vectors
+        template <unsigned int Width>
+        [[gnu::always_inline]] static inline void network(T* data);
+
+        /// @brief Merges sorted runs of Size/2 into runs of Size, then recurses up to Width
+        template <unsigned int Width, unsigned int Size>
+        [[gnu::always_inline]] static inline void merge(Vector* v);
+
+        /// @brief Compare exchange of i with i^Step, then recurses down to Step = 1
+        template <unsigned int Width, unsigned int Step>
+        [[gnu::always_inline]] static inline void halfClean(Vector* v);
+
+        /// @brief Compare exchange of lane l with lane l^Partner inside every vector, the lane with Bit set keeps the max
+        template <unsigned int Partner, unsigned int Bit, unsigned int Count>
+        [[gnu::always_inline]] static inline void exchangeLanes(Vector* v);
+
+        /// @brief Puts the lane wise min in low and the max in high
+        /// Vectors only go by reference so no 256 bit value is passed in a register of a non AVX caller
+        [[gnu::always_inline]] static inline void minMax(Vector& low, Vector& high);
+
+        [[gnu::always_inline]] static inline void reverse(Vector& v);
+
+};
+
+template <typename T>
+void SimdSortingNetwork<T>::sort(T* data, unsigned int n){
+    static const Kernel kernel = selectKernel();
+    //a NaN compares false both ways, the vector min and max then copy the other operand over it and the
+    //infinity padding no longer sorts last, so the networks only ever see ordered values
+    if constexpr(std::is_floating_point_v<T>)
+        n = moveNansBack(data, n);
+    kernel(data, n);
+}
+
+template <typename T>
+unsigned int SimdSortingNetwork<T>::moveNansBack(T* data, unsigned int n){
+    unsigned int ordered = 0;
+    for(unsigned int i = 0; i < n; i++){
+        if(data[i] == data[i])
+            std::swap(data[ordered++], data[i]);
+    }
+    return ordered;
+}
+
+template <typename T>
+typename SimdSortingNetwork<T>::Kernel SimdSortingNetwork<T>::selectKernel(){
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+        return &sortAvx2;
+    if(__builtin_cpu_supports("sse4.2"))
+        return &sortSse4;
+#endif
+    return &sortScalar;
+}
+
+template <typename T>
+void SimdSortingNetwork<T>::sortScalar(T* data, unsigned int n){
+    for(unsigned int i = 1; i < n; i++){
+        T curr = data[i];
+        unsigned int j = i;
+        while(j > 0 && curr < data[j-1]){
+            data[j] = data[j-1];
+            j--;
+        }
+        data[j] = curr;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template <typename T>
+void SimdSortingNetwork<T>::sortAvx2(T* data, unsigned int n){
+    sortPadded(data, n);
+}
+
+template <typename T>
+void SimdSortingNetwork<T>::sortSse4(T* data, unsigned int n){
+    sortPadded(data, n);
+}
+#endif
+
+template <typename T>
+void SimdSortingNetwork<T>::sortPadded(T* data, unsigned int n){
+    if(n < 2)
+        return;
+
+    //the padding is the largest value so it ends up past the n real elements
+    alignas(32) T buffer[maxSize];
+    std::memcpy(buffer, data, n * sizeof(T));
+    unsigned int width = n <= 8 ? 8 : n <= 16 ? 16 : n <= 32 ? 32 : 64;
+    for(unsigned int i = n; i < width; i++){
+        buffer[i] = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+    }
+
+    switch(width){
+        case 8: network<8>(buffer); break;
+        case 16: network<16>(buffer); break;
+        case 32: network<32>(buffer); break;
+        default: network<64>(buffer); break;
+    }
+    std::memcpy(data, buffer, n * sizeof(T));
+}
+
+template <typename T>
+template <unsigned int Width>
+void SimdSortingNetwork<T>::network(T* data){
+    Vector v[Width / lanes];
+    std::memcpy(v, data, sizeof(v));
+    merge<Width, 2>(v);
+    std::memcpy(data, v, sizeof(v));
+}
+
+template <typename T>
+template <unsigned int Width, unsigned int Size>
+void SimdSortingNetwork<T>::merge(Vector* v){
+    constexpr unsigned int count = Width / lanes;
+
+    //merging two sorted halves of length Size/2 starts with a flip, comparing i with i^(Size-1),
+    //so the smaller value always goes to the lower index and no step needs a direction
+    if constexpr(Size <= lanes){
+        exchangeLanes<Size - 1, Size / 2, count>(v);
+    }
+    else{
+        constexpr unsigned int block = Size / lanes;
+        for(unsigned int r = 0; r < count; r++){
+            if(r % block < block / 2){
+                unsigned int other = r ^ (block - 1);
+                reverse(v[other]);
+                minMax(v[r], v[other]);
+                reverse(v[other]);
+            }
+        }
+    }
+    halfClean<Width, Size / 4>(v);
+
+    if constexpr(Size < Width)
+        merge<Width, Size * 2>(v);
+}
+
+template <typename T>
+template <unsigned int Width, unsigned int Step>
+void SimdSortingNetwork<T>::halfClean(Vector* v){
+    constexpr unsigned int count = Width / lanes;
+    if constexpr(Step >= lanes){
+        constexpr unsigned int jump = Step / lanes;
+        for(unsigned int r = 0; r < count; r++){
+            if(!(r & jump)){
+                minMax(v[r], v[r | jump]);
+            }
+        }
+    }
+    else if constexpr(Step >= 1){
+        exchangeLanes<Step, Step, count>(v);
+    }
+
+    if constexpr(Step > 1)
+        halfClean<Width, Step / 2>(v);
+}
+
+template <typename T>
+template <unsigned int Partner, unsigned int Bit, unsigned int Count>
+void SimdSortingNetwork<T>::exchangeLanes(Vector* v){
+    //lane l pairs with l^Partner and takes the max from the second vector when it has Bit set,
+    //both masks are constants once inlined
+    Index partner, blend;
+    for(unsigned int l = 0; l < lanes; l++){
+        partner[l] = l ^ Partner;
+        blend[l] = (l & Bit) ? l + lanes : l;
+    }
+    for(unsigned int r = 0; r < Count; r++){
+        Vector low = v[r];
+        Vector high = __builtin_shuffle(v[r], partner);
+        minMax(low, high);
+        v[r] = __builtin_shuffle(low, high, blend);
+    }
+}
+
+template <typename T>
+void SimdSortingNetwork<T>::minMax(Vector& low, Vector& high){
+    Vector smaller = high < low ? high : low;
+    high = high < low ? low : high;
+    low = smaller;
+}
+
+template <typename T>
+void SimdSortingNetwork<T>::reverse(Vector& v){
+    Index mask;
+    for(unsigned int l = 0; l < lanes; l++){
+        mask[l] = lanes - 1 - l;
+    }
+    v = __builtin_shuffle(v, mask);
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "simdSort.hpp"
+#include "sortingAlgorithms.hpp"
+#include "../check.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+/// @brief Checks vec holds the same values as input, NaNs counted apart since they equal nothing
+template <typename T>
+static bool samePermutation(std::vector<T> vec, std::vector<T> input){
+    auto nans = [](const std::vector<T>& values){ return std::count_if(values.begin(), values.end(), [](T x){ return x != x; }); };
+    if(nans(vec) != nans(input))
+        return false;
+    std::erase_if(vec, [](T x){ return x != x; });
+    std::erase_if(input, [](T x){ return x != x; });
+    std::sort(vec.begin(), vec.end());
+    std::sort(input.begin(), input.end());
+    return vec == input;
+}
+
+template <typename T>
+static void nanInput(){
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    std::vector<T> small = {3, nan, 1, 2, 0};
+    SimdSortingNetwork<T>::sort(small.data(), small.size());
+    check::that(small[0] == 0 && small[1] == 1 && small[2] == 2 && small[3] == 3 && std::isnan(small[4]),
+                "NaN is moved last and the rest is sorted");
+
+    //every size the kernel takes, with NaNs, infinities and the padding value mixed in
+    std::mt19937 rng(4);
+    for(unsigned int n = 0; n <= SimdSortingNetwork<T>::maxSize; n++){
+        std::vector<T> input(n);
+        for(T& value : input){
+            unsigned int pick = rng() % 8;
+            value = pick == 0 ? nan : pick == 1 ? std::numeric_limits<T>::infinity() : T(rng() % 16);
+        }
+        std::vector<T> vec = input;
+        SimdSortingNetwork<T>::sort(vec.data(), n);
+        auto firstNan = std::find_if(vec.begin(), vec.end(), [](T x){ return x != x; });
+        check::that(samePermutation(vec, input), "network output is a permutation of the input");
+        check::that(std::is_sorted(vec.begin(), firstNan) && std::all_of(firstNan, vec.end(), [](T x){ return x != x; }),
+                    "network sorts the values before the NaNs");
+    }
+
+    //the recursive sorts end in the network, they have to keep every value even if NaN makes the order undefined
+    std::vector<T> input(5000);
+    for(T& value : input)
+        value = rng() % 10 == 0 ? nan : T(rng() % 1000);
+    std::vector<std::function<void(std::vector<T>&)>> sorts = {
+        [](std::vector<T>& vec){ SortingAlgorithms<T>::introSort(vec); },
+        [](std::vector<T>& vec){ SortingAlgorithms<T>::mergeSort(vec); },
+        [](std::vector<T>& vec){ SortingAlgorithms<T>::nthElement(vec, vec.size() / 2); },
+    };
+    for(auto& sort : sorts){
+        std::vector<T> vec = input;
+        sort(vec);
+        check::that(samePermutation(vec, input), "sort with NaN input keeps every value");
+    }
+}
+
+int main(){
+    nanInput<float>();
+    nanInput<double>();
+
+    std::vector<int> ints = {5, std::numeric_limits<int>::max(), -3, 0, std::numeric_limits<int>::min()};
+    SimdSortingNetwork<int>::sort(ints.data(), ints.size());
+    check::that(std::is_sorted(ints.begin(), ints.end()), "ints up to the padding value sort");
+    return check::failures();
+}
@@ -3,7 +3,27 @@
 
 #include <vector>
 #include <iostream>
-#include "../DS/heap.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "simdSort.hpp"
+#include "sortingNetwork.hpp"
+#include "stringSort.hpp"
+#include "threadPool.hpp"
+
+/// @brief How quick sort style algorithms split a range around the pivot
+enum class PartitionScheme{
+    /// @brief One pass with a branch per element, simplest but mispredicts about half the time on random data
+    Lomuto,
+    /// @brief BlockQuicksort, comparison results are stored as offsets without branching and swapped in bulk
+    Block
+};
 
 /// @brief Class with several sorting algorithms
 /// @tparam T Type of vector to sort
@@ -23,13 +43,83 @@ class SortingAlgorithms{
         /// @brief Performs merge sort with O(N*Log(N)) time
         static inline void mergeSort(std::vector<T>& vec);
 
-        /// @brief 
-        /// @param vec 
-        static inline void quickSort(std::vector<T>& vec);
+        /// @brief Stable bottom up merge sort with O(N*Log(N)) time, allocates one scratch buffer and
+        /// alternates the merge passes between it and vec, moving elements instead of copying them
+        static inline void bottomUpMergeSort(std::vector<T>& vec);
+
+        /// @brief Bottom up merge sort using a scratch buffer owned by the caller
+        /// @param buffer Resized to vec.size() if smaller, so it can be reused across calls without allocating
+        static inline void bottomUpMergeSort(std::vector<T>& vec, std::vector<T>& buffer);
+
+        /// @brief Adaptive stable merge sort (powersort), O(N) on sorted or reversed input and O(N*Log(N)) worst case
+        /// Merges natural runs, reversing descending ones, with galloping and the powersort merge policy
+        static inline void powerSort(std::vector<T>& vec);
 
-        /// @brief Uses Max heap with O(N*Log(N)) time
+        /// @brief Quick sort on the last element as pivot, O(N*Log(N)) on average and O(N^2) worst case
+        /// @param scheme Partition used to split every range
+        static inline void quickSort(std::vector<T>& vec, PartitionScheme scheme = PartitionScheme::Lomuto);
+
+        /// @brief In place heap sort with O(N*Log(N)) time and O(1) extra space
+        /// Builds a max heap bottom up in O(N) and extracts with Floyd's sift to the leaves
         static inline void heapSort(std::vector<T>& vec);
 
+        /// @brief Introsort: median of three/ninther quick sort that switches to heap sort past 2*Log(N)
+        /// depth and to insertion sort on small ranges, O(N*Log(N)) worst case
+        /// @param scheme Partition used to split every range, Block avoids the branch mispredictions of Lomuto
+        static inline void introSort(std::vector<T>& vec, PartitionScheme scheme = PartitionScheme::Block);
+
+        /// @brief LSD radix sort on 8 bit digits with O(N) time, only for integer and float/double keys
+        /// Passes where every key has the same digit are skipped
+        /// std::string goes to StringSort's MSD radix sort instead
+        static inline void radixSort(std::vector<T>& vec);
+
+        /// @brief Introselect: puts the element that would be at index n after sorting there, with nothing greater
+        /// before it and nothing smaller after it, in expected O(N) time and O(N*Log(N)) worst case
+        static inline void nthElement(std::vector<T>& vec, unsigned int n);
+
+        /// @brief Sorts the k smallest elements into vec[0, k) in O(N + k*Log(k)), the rest are left in any order
+        static inline void partialSort(std::vector<T>& vec, unsigned int k);
+
+        /// @brief Gets the k largest elements in descending order in O(N + k*Log(k)), reorders vec while selecting
+        static inline std::vector<T> topK(std::vector<T>& vec, unsigned int k);
+
+        /// @brief Indirect sort, computes every key once and sorts the (key, index) pairs instead of moving T
+        /// @param key Function mapping an element to the key it is ordered by
+        /// @return Returns the permutation where result[k] is the index of the k-th smallest element, ties keep input order
+        template <typename KeyFunction>
+        static inline std::vector<uint32_t> argSort(const std::vector<T>& vec, KeyFunction key);
+
+        /// @brief Reorders vec so vec[k] becomes the old vec[permutation[k]], following cycles so every element moves once
+        /// Throws std::invalid_argument unless permutation holds every index of vec exactly once
+        static inline void applyPermutation(std::vector<T>& vec, const std::vector<uint32_t>& permutation);
+
+        /// @brief Quick sort that hands the left partition to a work stealing thread pool
+        /// @param threads Number of threads to use, 0 runs on ThreadPool::shared() instead of starting a pool
+        /// @param grain Partitions smaller than this are sorted serially
+        static inline void parallelQuickSort(std::vector<T>& vec, unsigned int threads = 0, int grain = 1 << 14);
+
+        /// @brief Quick sort on a pool the caller keeps, so repeated sorts do not start and join threads
+        static inline void parallelQuickSort(std::vector<T>& vec, ThreadPool& pool, int grain = 1 << 14);
+
+        /// @brief Merge sort that sorts both halves in parallel on a work stealing thread pool
+        /// @param threads Number of threads to use, 0 runs on ThreadPool::shared() instead of starting a pool
+        /// @param grain Ranges smaller than this are sorted serially
+        static inline void parallelMergeSort(std::vector<T>& vec, unsigned int threads = 0, int grain = 1 << 14);
+
+        /// @brief Merge sort on a pool the caller keeps, so repeated sorts do not start and join threads
+        static inline void parallelMergeSort(std::vector<T>& vec, ThreadPool& pool, int grain = 1 << 14);
+
+        /// @brief Sample sort: every thread classifies its slice into buckets against oversampled splitters,
+        /// the buckets are scattered with one prefix sum and then introsorted independently
+        /// Once two neighbouring splitters are equal, keys equal to a splitter go to a bucket of their own that needs no sort
+        /// Needs O(N) extra space, synchronizes only between the classify, scatter and sort phases
+        /// @param threads Number of threads to use, 0 runs on ThreadPool::shared() instead of starting a pool
+        /// @param grain Average bucket size aimed for, inputs below two grains are sorted serially
+        static inline void parallelSampleSort(std::vector<T>& vec, unsigned int threads = 0, int grain = 1 << 14);
+
+        /// @brief Sample sort on a pool the caller keeps, so repeated sorts do not start and join threads
+        static inline void parallelSampleSort(std::vector<T>& vec, ThreadPool& pool, int grain = 1 << 14);
+
     private:
 
         /// @brief Helper function for merge sort
@@ -38,9 +128,135 @@ class SortingAlgorithms{
         /// @param end End index
         static void mergeHelper(std::vector<T>& vec, int begin, int end);
 
-        static void quickSortHelper(std::vector<T>&, int low, int high);
+        /// @brief Merges the sorted ranges [begin, mid] and [mid+1, end]
+        static void merge(std::vector<T>& vec, int begin, int mid, int end);
+
+        /// @brief Moves the merge of the sorted ranges src[begin, mid) and src[mid, end) into dst[begin, end)
+        static void mergeInto(T* src, T* dst, size_t begin, size_t mid, size_t end);
+
+        /// @brief Moves the stable merge of the sorted spans [left, leftEnd) and [right, rightEnd) to out
+        static void mergeSpans(T* left, T* leftEnd, T* right, T* rightEnd, T* out);
+
+        /// @brief Bottom up merge sort of vec[begin, end) using buffer[begin, end) as the other half of the ping-pong
+        static void bottomUpMergeRange(std::vector<T>& vec, T* buffer, size_t begin, size_t end);
+
+        /// @brief Natural run waiting on the powersort stack, power belongs to the boundary after it
+        struct Run{
+            size_t start;
+            size_t length;
+            int power;
+        };
+
+        /// @brief Consecutive wins of one side before a merge switches to galloping
+        static constexpr size_t minGallop = 7;
+
+        /// @brief Finds the run starting at low, reversing it if strictly descending
+        /// @return Returns the run length
+        static size_t findRun(std::vector<T>& vec, size_t low, size_t high);
+
+        /// @brief Extends the sorted prefix [low, low+sorted) to [low, high) with binary insertion sort
+        static void binaryInsertionSort(std::vector<T>& vec, size_t low, size_t sorted, size_t high);
+
+        /// @brief Gets the powersort power of the boundary between runs [s1, s1+n1) and [s1+n1, s1+n1+n2)
+        static int nodePower(size_t s1, size_t n1, size_t n2, size_t n);
+
+        /// @brief Stable merge of the adjacent runs a and b, buffer holds the smaller one
+        static void mergeRuns(std::vector<T>& vec, Run a, Run b, std::vector<T>& buffer);
+
+        /// @brief Exponential then binary search for the first index of base[0, length) where pred is false
+        template <typename Predicate>
+        static size_t gallopFirst(const T* base, size_t length, Predicate pred);
+
+        /// @brief Exponential then binary search from the end for how many trailing elements pred is true on
+        template <typename Predicate>
+        static size_t gallopLast(const T* base, size_t length, Predicate pred);
+
+        static void quickSortHelper(std::vector<T>&, int low, int high, PartitionScheme scheme);
+
+        /// @brief Partitions [low, high] around the pivot at vec[high] with the given scheme
+        /// @return Returns the final index of the pivot, everything before it is smaller and nothing after it is
+        static int partition(std::vector<T>& vec, int low, int high, PartitionScheme scheme = PartitionScheme::Lomuto);
+
+        static int lomutoPartition(std::vector<T>& vec, int low, int high);
+
+        static int blockPartition(std::vector<T>& vec, int low, int high);
+
+        /// @brief Elements looked at per side before blockPartition swaps, offsets have to fit in a byte
+        static constexpr int partitionBlock = 64;
+
+        /// @brief Ranges at most this long are finished with insertion sort
+        static constexpr int insertionThreshold = 16;
+
+        /// @brief Gets the 2*Log(N) recursion cap of introsort
+        static int depthLimit(int size);
+
+        /// @brief Ranges at most this long are left to leafSort by the recursive sorts
+        static constexpr int leafThreshold = SimdSortingNetwork<T>::supported ? SimdSortingNetwork<T>::maxSize : insertionThreshold;
+
+        /// @brief Sorts a small range with the vector sorting network when T has one, otherwise with the
+        /// compile time network for its size, not stable
+        static void leafSort(std::vector<T>& vec, int low, int high);
+
+        /// @brief Runs the SortingNetwork for the size of [low, high], which has to be at most insertionThreshold long
+        static void networkSort(std::vector<T>& vec, int low, int high);
+
+        static void introSortHelper(std::vector<T>& vec, int low, int high, int depthLimit,
+                                    PartitionScheme scheme = PartitionScheme::Block);
+
+        /// @brief Picks the median of three, or the ninther for big ranges, and moves it to vec[high]
+        static void choosePivot(std::vector<T>& vec, int low, int high);
+
+        /// @brief Gets the index holding the median of the three values
+        static int medianOfThree(std::vector<T>& vec, int a, int b, int c);
+
+        /// @brief Insertion sort on [low, high] that shifts instead of swapping
+        static void insertionSortRange(std::vector<T>& vec, int low, int high);
+
+        /// @brief Heap sort on [low, high] in place
+        static void heapSortRange(std::vector<T>& vec, int low, int high);
+
+        /// @brief Iterative sift down of a max heap stored at vec[low, low+size)
+        static void siftDown(std::vector<T>& vec, int low, int root, int size);
+
+        /// @brief LSD radix sort of integer and floating point keys
+        static void numericRadixSort(std::vector<T>& vec);
+
+        /// @brief Unsigned integer as wide as T, used as the radix sort key
+        using RadixKey = std::conditional_t<sizeof(T) == 1, uint8_t,
+                         std::conditional_t<sizeof(T) == 2, uint16_t,
+                         std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
 
-        static int partition(std::vector<T>& vec, int low, int high);
+        /// @brief Maps a value to an unsigned key with the same ordering
+        /// Signed integers flip the sign bit, floats flip every bit if negative and only the sign bit otherwise
+        static RadixKey radixKey(T value);
+
+        /// @brief Inverse of radixKey
+        static T radixValue(RadixKey key);
+
+        /// @param depth Partitions left before falling back to heap sort, shared down the whole recursion like introSort's
+        static void parallelQuickSortHelper(std::vector<T>& vec, int low, int high, TaskGroup& group, int grain, int depth);
+
+        /// @brief Sorts vec[begin, end) with the halves sorted in parallel, the result ends up in buffer when
+        /// intoBuffer is set and in vec otherwise, so every level merges from one array into the other without copying back
+        static void parallelMergeHelper(std::vector<T>& vec, T* buffer, size_t begin, size_t end, bool intoBuffer,
+                                        ThreadPool& pool, int grain);
+
+        /// @brief Merges src[begin, mid) and src[mid, end) into dst[begin, end) in chunks of about grain outputs,
+        /// each chunk finds where it starts in both halves by merge path co-ranking and merges on its own
+        static void parallelMergeInto(T* src, T* dst, size_t begin, size_t mid, size_t end, ThreadPool& pool, int grain);
+
+        /// @brief Merge path co-rank of two sorted spans, how many of the first rank outputs come from the left one
+        /// Ties go to the left span, the same order mergeSpans writes them in
+        static size_t coRank(const T* left, size_t leftSize, const T* right, size_t rightSize, size_t rank);
+
+        /// @brief Most buckets a sample sort splits into, bucket ids have to fit in a byte
+        static constexpr unsigned int maxBuckets = 256;
+
+        /// @brief Sample elements taken per bucket, more makes the bucket sizes more even
+        static constexpr unsigned int oversampling = 16;
+
+        /// @brief Stores the sorted splitters as an implicit search tree in Eytzinger order, tree[1] is the root
+        static void buildSplitterTree(const std::vector<T>& splitters, std::vector<T>& tree, unsigned int node, unsigned int& next);
 };  
 
 template <typename T>
@@ -91,76 +307,388 @@ void SortingAlgorithms<T>::mergeSort(std::vector<T>& vec){
 }
 
 template <typename T>
-void SortingAlgorithms<T>::quickSort(std::vector<T>& vec){
-    int low = 0;
-    int high = vec.size() -1;
-    quickSortHelper(vec, low, high);
+void SortingAlgorithms<T>::bottomUpMergeSort(std::vector<T>& vec){
+    std::vector<T> buffer;
+    bottomUpMergeSort(vec, buffer);
 }
 
 template <typename T>
-void SortingAlgorithms<T>::heapSort(std::vector<T>& vec){
-    Heap<T> heap;
+void SortingAlgorithms<T>::bottomUpMergeSort(std::vector<T>& vec, std::vector<T>& buffer){
+    size_t size = vec.size();
+    if(size < 2)
+        return;
+    if(buffer.size() < size)
+        buffer.resize(size);
+    bottomUpMergeRange(vec, buffer.data(), 0, size);
+}
 
-    for(unsigned int i = 0; i < vec.size(); i++){
-        heap.insert(vec[i]);
+template <typename T>
+void SortingAlgorithms<T>::bottomUpMergeRange(std::vector<T>& vec, T* buffer, size_t begin, size_t end){
+    //insertion sort runs first so the short passes, which are the most expensive per element, are skipped
+    for(size_t low = begin; low < end; low += insertionThreshold){
+        size_t high = std::min(low + insertionThreshold, end);
+        insertionSortRange(vec, low, high - 1);
+    }
+
+    T* src = vec.data();
+    T* dst = buffer;
+    for(size_t width = insertionThreshold; width < end - begin; width *= 2){
+        for(size_t low = begin; low < end; low += 2 * width){
+            size_t mid = std::min(low + width, end);
+            size_t high = std::min(low + 2 * width, end);
+            mergeInto(src, dst, low, mid, high);
+        }
+        std::swap(src, dst);
+    }
+
+    //odd number of passes left the result in the buffer
+    if(src != vec.data())
+        std::move(src + begin, src + end, vec.data() + begin);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::mergeInto(T* src, T* dst, size_t begin, size_t mid, size_t end){
+    mergeSpans(src + begin, src + mid, src + mid, src + end, dst + begin);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::mergeSpans(T* left, T* leftEnd, T* right, T* rightEnd, T* out){
+    while(left < leftEnd && right < rightEnd){
+        //taking from the right only when strictly smaller keeps equal elements in order
+        if(*right < *left)
+            *out++ = std::move(*right++);
+        else
+            *out++ = std::move(*left++);
+    }
+    out = std::move(left, leftEnd, out);
+    std::move(right, rightEnd, out);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::powerSort(std::vector<T>& vec){
+    size_t size = vec.size();
+    if(size < 2)
+        return;
+
+    //short natural runs are grown to minRun with binary insertion sort so merges stay balanced
+    size_t minRun = size;
+    size_t odd = 0;
+    while(minRun >= 64){
+        odd |= minRun & 1;
+        minRun >>= 1;
+    }
+    minRun += odd;
+
+    std::vector<T> buffer;
+    std::vector<Run> stack;
+    size_t low = 0;
+    size_t length = findRun(vec, 0, size);
+    if(length < minRun){
+        size_t forced = std::min(minRun, size);
+        binaryInsertionSort(vec, 0, length, forced);
+        length = forced;
+    }
+    stack.push_back({0, length, 0});
+    low = length;
+
+    while(low < size){
+        length = findRun(vec, low, size);
+        if(length < minRun){
+            size_t forced = std::min(minRun, size - low);
+            binaryInsertionSort(vec, low, length, low + forced);
+            length = forced;
+        }
+
+        //runs whose boundary is deeper in the virtual merge tree than the new one get merged first
+        Run& last = stack.back();
+        int power = nodePower(last.start, last.length, length, size);
+        while(stack.size() > 1 && stack[stack.size() - 2].power > power){
+            Run right = stack.back();
+            stack.pop_back();
+            Run& left = stack.back();
+            mergeRuns(vec, left, right, buffer);
+            left.length += right.length;
+        }
+        stack.back().power = power;
+        stack.push_back({low, length, 0});
+        low += length;
+    }
+
+    while(stack.size() > 1){
+        Run right = stack.back();
+        stack.pop_back();
+        Run& left = stack.back();
+        mergeRuns(vec, left, right, buffer);
+        left.length += right.length;
+    }
+}
+
+template <typename T>
+size_t SortingAlgorithms<T>::findRun(std::vector<T>& vec, size_t low, size_t high){
+    size_t end = low + 1;
+    if(end == high)
+        return 1;
+
+    if(vec[end] < vec[low]){
+        //only strictly descending runs are reversed, reversing equal elements would break stability
+        end++;
+        while(end < high && vec[end] < vec[end - 1])
+            end++;
+        std::reverse(vec.begin() + low, vec.begin() + end);
+    }
+    else{
+        end++;
+        while(end < high && !(vec[end] < vec[end - 1]))
+            end++;
+    }
+    return end - low;
+}
+
+template <typename T>
+void SortingAlgorithms<T>::binaryInsertionSort(std::vector<T>& vec, size_t low, size_t sorted, size_t high){
+    for(size_t i = low + std::max<size_t>(sorted, 1); i < high; i++){
+        //upper bound so equal elements stay behind the ones already placed
+        auto pos = std::upper_bound(vec.begin() + low, vec.begin() + i, vec[i]);
+        T curr = std::move(vec[i]);
+        std::move_backward(pos, vec.begin() + i, vec.begin() + i + 1);
+        *pos = std::move(curr);
+    }
+}
+
+template <typename T>
+int SortingAlgorithms<T>::nodePower(size_t s1, size_t n1, size_t n2, size_t n){
+    //number of leading bits the two run midpoints share as fractions of n, plus one
+    size_t a = 2 * s1 + n1;
+    size_t b = a + n1 + n2;
+    int power = 0;
+    while(true){
+        power++;
+        if(a >= n){
+            a -= n;
+            b -= n;
+        }
+        else if(b >= n){
+            break;
+        }
+        a <<= 1;
+        b <<= 1;
+    }
+    return power;
+}
+
+template <typename T>
+template <typename Predicate>
+size_t SortingAlgorithms<T>::gallopFirst(const T* base, size_t length, Predicate pred){
+    size_t last = 0;
+    size_t step = 1;
+    while(step <= length && pred(base[step - 1])){
+        last = step;
+        step = step * 2 + 1;
+    }
+    size_t high = std::min(step, length);
+    //answer is in (last, high], pred holds on base[0, last)
+    while(last < high){
+        size_t mid = last + (high - last) / 2;
+        if(pred(base[mid]))
+            last = mid + 1;
+        else
+            high = mid;
+    }
+    return last;
+}
+
+template <typename T>
+template <typename Predicate>
+size_t SortingAlgorithms<T>::gallopLast(const T* base, size_t length, Predicate pred){
+    size_t found = 0;
+    size_t step = 1;
+    while(step <= length && pred(base[length - step])){
+        found = step;
+        step = step * 2 + 1;
+    }
+    size_t high = std::min(step, length);
+    //pred holds on the last found elements and fails somewhere before the last high ones
+    while(found < high){
+        size_t mid = found + (high - found) / 2;
+        if(pred(base[length - 1 - mid]))
+            found = mid + 1;
+        else
+            high = mid;
     }
+    return found;
+}
+
+template <typename T>
+void SortingAlgorithms<T>::mergeRuns(std::vector<T>& vec, Run a, Run b, std::vector<T>& buffer){
+    T* data = vec.data();
+
+    //elements of a that are not above b's first element and elements of b that are not below a's last are already in place
+    size_t skip = gallopFirst(data + a.start, a.length, [&](const T& x){ return !(data[b.start] < x); });
+    a.start += skip;
+    a.length -= skip;
+    if(a.length == 0)
+        return;
+    b.length -= gallopLast(data + b.start, b.length, [&](const T& x){ return !(x < data[a.start + a.length - 1]); });
+    if(b.length == 0)
+        return;
 
-    unsigned int back = vec.size() -1; //using max heap so insert in back
+    if(a.length <= b.length){
+        //a goes to the buffer and the merge runs forward, the output never passes the unread part of b
+        buffer.resize(std::max(buffer.size(), a.length));
+        std::move(data + a.start, data + a.start + a.length, buffer.begin());
+        T* left = buffer.data();
+        T* leftEnd = left + a.length;
+        T* right = data + b.start;
+        T* rightEnd = right + b.length;
+        T* dest = data + a.start;
+        size_t leftWins = 0;
+        size_t rightWins = 0;
+        while(left < leftEnd && right < rightEnd){
+            if(*right < *left){
+                *dest++ = std::move(*right++);
+                rightWins++;
+                leftWins = 0;
+            }
+            else{
+                *dest++ = std::move(*left++);
+                leftWins++;
+                rightWins = 0;
+            }
 
-    while(!heap.empty()){
-        vec[back] = heap.getMax();
-        heap.removeMax();
-        back--;
+            if(leftWins >= minGallop && right < rightEnd){
+                size_t count = gallopFirst(left, leftEnd - left, [&](const T& x){ return !(*right < x); });
+                dest = std::move(left, left + count, dest);
+                left += count;
+                leftWins = 0;
+            }
+            else if(rightWins >= minGallop && left < leftEnd){
+                size_t count = gallopFirst(right, rightEnd - right, [&](const T& x){ return x < *left; });
+                dest = std::move(right, right + count, dest);
+                right += count;
+                rightWins = 0;
+            }
+        }
+        std::move(left, leftEnd, dest);
     }
+    else{
+        //b goes to the buffer and the merge runs backward from the end of b
+        buffer.resize(std::max(buffer.size(), b.length));
+        std::move(data + b.start, data + b.start + b.length, buffer.begin());
+        T* leftBegin = data + a.start;
+        T* left = leftBegin + a.length;
+        T* rightBegin = buffer.data();
+        T* right = rightBegin + b.length;
+        T* dest = data + b.start + b.length;
+        size_t leftWins = 0;
+        size_t rightWins = 0;
+        while(left > leftBegin && right > rightBegin){
+            if(*(right - 1) < *(left - 1)){
+                *--dest = std::move(*--left);
+                leftWins++;
+                rightWins = 0;
+            }
+            else{
+                *--dest = std::move(*--right);
+                rightWins++;
+                leftWins = 0;
+            }
+
+            if(leftWins >= minGallop && right > rightBegin){
+                size_t count = gallopLast(leftBegin, left - leftBegin, [&](const T& x){ return *(right - 1) < x; });
+                dest = std::move_backward(left - count, left, dest);
+                left -= count;
+                leftWins = 0;
+            }
+            else if(rightWins >= minGallop && left > leftBegin){
+                size_t count = gallopLast(rightBegin, right - rightBegin, [&](const T& x){ return !(x < *(left - 1)); });
+                dest = std::move_backward(right - count, right, dest);
+                right -= count;
+                rightWins = 0;
+            }
+        }
+        std::move_backward(rightBegin, right, dest);
+    }
+}
+
+template <typename T>
+void SortingAlgorithms<T>::quickSort(std::vector<T>& vec, PartitionScheme scheme){
+    int low = 0;
+    int high = vec.size() -1;
+    quickSortHelper(vec, low, high, scheme);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::heapSort(std::vector<T>& vec){
+    if(vec.size() < 2)
+        return;
+    heapSortRange(vec, 0, vec.size() - 1);
 }
 
 template <typename T>
 void SortingAlgorithms<T>::mergeHelper(std::vector<T>& vec, int begin, int end) {
-    if (begin >= end)
+    if (end - begin + 1 <= leafThreshold) {
+        //networks do not keep equal elements in order, types that can tell equal elements apart get insertion sort
+        if constexpr(SimdSortingNetwork<T>::supported)
+            leafSort(vec, begin, end);
+        else
+            insertionSortRange(vec, begin, end);
         return;
+    }
 
     //recursively call mergeHelper until vectors of size 1 and then merge
     int mid = begin + (end - begin) / 2;
     mergeHelper(vec, begin, mid);
     mergeHelper(vec, mid + 1, end);
+    merge(vec, begin, mid, end);
+}
 
-    //create temp new vector to merge subvectors
+template <typename T>
+void SortingAlgorithms<T>::merge(std::vector<T>& vec, int begin, int mid, int end) {
+    //create temp new vector to merge subvectors, sized once so push_back never reallocates
     std::vector<T> temp;
+    temp.reserve(end - begin + 1);
     int left = begin;
     int right = mid + 1;
 
     //while left and right subvectors both still have values
     while (left <= mid && right <= end) {
         if (vec[left] <= vec[right]) {
-            temp.push_back(vec[left]);
+            temp.push_back(std::move(vec[left]));
             left++;
         } 
         else {
-            temp.push_back(vec[right]);
+            temp.push_back(std::move(vec[right]));
             right++;
         }
     }
 
     //if left vector was bigger than right
     while (left <= mid) {
-        temp.push_back(vec[left]);
+        temp.push_back(std::move(vec[left]));
         left++;
     }
 
     //if right vector was bigger than left
     while (right <= end) {
-        temp.push_back(vec[right]);
+        temp.push_back(std::move(vec[right]));
         right++;
     }
 
     //update the vector with new values
     for (int i = begin, j = 0; i <= end; i++, j++) { 
-        vec[i] = temp[j];
+        vec[i] = std::move(temp[j]);
     }
 }
 
 template <typename T>
-int SortingAlgorithms<T>::partition(std::vector<T>& vec, int low, int high){
+int SortingAlgorithms<T>::partition(std::vector<T>& vec, int low, int high, PartitionScheme scheme){
+    if(scheme == PartitionScheme::Block)
+        return blockPartition(vec, low, high);
+    return lomutoPartition(vec, low, high);
+}
+
+template <typename T>
+int SortingAlgorithms<T>::lomutoPartition(std::vector<T>& vec, int low, int high){
     T pivot = vec[high];
     int i = low - 1;
 
@@ -176,11 +704,759 @@ int SortingAlgorithms<T>::partition(std::vector<T>& vec, int low, int high){
 }
 
 template <typename T>
-void SortingAlgorithms<T>::quickSortHelper(std::vector<T>& vec, int low, int high){
-    if(low < high){
-        int pivot = partition(vec, low, high);
-        quickSortHelper(vec, low, pivot-1);
-        quickSortHelper(vec, pivot+1, high);
+int SortingAlgorithms<T>::blockPartition(std::vector<T>& vec, int low, int high){
+    const T pivot = vec[high];
+    T* first = vec.data() + low;
+    T* last = vec.data() + high; //the pivot stays at high, [first, last) is what is left to split
+
+    //left offsets count from first and mark elements that belong right, right offsets count
+    //back from last starting at 1 and mark elements that belong left
+    unsigned char offsetsLeft[partitionBlock];
+    unsigned char offsetsRight[partitionBlock];
+    int startLeft = 0;
+    int startRight = 0;
+    int numLeft = 0;
+    int numRight = 0;
+
+    while(last - first > 2 * partitionBlock){
+        //the comparison result is added instead of branched on, so the offset is always written
+        //and only kept when the next one does not overwrite it
+        if(numLeft == 0){
+            startLeft = 0;
+            for(int i = 0; i < partitionBlock; i++){
+                offsetsLeft[numLeft] = i;
+                numLeft += !(first[i] < pivot);
+            }
+        }
+        if(numRight == 0){
+            startRight = 0;
+            for(int i = 1; i <= partitionBlock; i++){
+                offsetsRight[numRight] = i;
+                numRight += *(last - i) < pivot;
+            }
+        }
+
+        int num = std::min(numLeft, numRight);
+        for(int i = 0; i < num; i++){
+            std::swap(first[offsetsLeft[startLeft + i]], *(last - offsetsRight[startRight + i]));
+        }
+        numLeft -= num;
+        numRight -= num;
+        startLeft += num;
+        startRight += num;
+        if(numLeft == 0)
+            first += partitionBlock;
+        if(numRight == 0)
+            last -= partitionBlock;
+    }
+
+    //fewer than two blocks are left, a block with pending offsets keeps its size and the other side gets the rest
+    int unknown = (last - first) - ((numLeft || numRight) ? partitionBlock : 0);
+    int sizeLeft;
+    int sizeRight;
+    if(numRight){
+        sizeLeft = unknown;
+        sizeRight = partitionBlock;
+    }
+    else if(numLeft){
+        sizeLeft = partitionBlock;
+        sizeRight = unknown;
+    }
+    else{
+        sizeLeft = unknown / 2;
+        sizeRight = unknown - sizeLeft;
+    }
+
+    if(unknown && numLeft == 0){
+        startLeft = 0;
+        for(int i = 0; i < sizeLeft; i++){
+            offsetsLeft[numLeft] = i;
+            numLeft += !(first[i] < pivot);
+        }
+    }
+    if(unknown && numRight == 0){
+        startRight = 0;
+        for(int i = 1; i <= sizeRight; i++){
+            offsetsRight[numRight] = i;
+            numRight += *(last - i) < pivot;
+        }
+    }
+
+    int num = std::min(numLeft, numRight);
+    for(int i = 0; i < num; i++){
+        std::swap(first[offsetsLeft[startLeft + i]], *(last - offsetsRight[startRight + i]));
+    }
+    numLeft -= num;
+    numRight -= num;
+    startLeft += num;
+    startRight += num;
+    if(numLeft == 0)
+        first += sizeLeft;
+    if(numRight == 0)
+        last -= sizeRight;
+
+    //one side still has misplaced elements, they are swapped to the boundary from the far end inwards
+    if(numLeft){
+        while(numLeft--)
+            std::swap(first[offsetsLeft[startLeft + numLeft]], *--last);
+        first = last;
+    }
+    if(numRight){
+        while(numRight--)
+            std::swap(*(last - offsetsRight[startRight + numRight]), *first++);
+    }
+
+    int boundary = first - vec.data();
+    std::swap(vec[boundary], vec[high]);
+    return boundary;
+}
+
+template <typename T>
+void SortingAlgorithms<T>::quickSortHelper(std::vector<T>& vec, int low, int high, PartitionScheme scheme){
+    if(high - low + 1 <= leafThreshold){
+        leafSort(vec, low, high);
+    }
+    else{
+        int pivot = partition(vec, low, high, scheme);
+        quickSortHelper(vec, low, pivot-1, scheme);
+        quickSortHelper(vec, pivot+1, high, scheme);
+    }
+}
+
+template <typename T>
+void SortingAlgorithms<T>::introSort(std::vector<T>& vec, PartitionScheme scheme){
+    if(vec.size() < 2)
+        return;
+    introSortHelper(vec, 0, vec.size() - 1, depthLimit(vec.size()), scheme);
+}
+
+template <typename T>
+int SortingAlgorithms<T>::depthLimit(int size){
+    int limit = 0;
+    for(; size > 1; size >>= 1)
+        limit += 2;
+    return limit;
+}
+
+template <typename T>
+void SortingAlgorithms<T>::introSortHelper(std::vector<T>& vec, int low, int high, int depthLimit, PartitionScheme scheme){
+    while(high - low + 1 > leafThreshold){
+        if(depthLimit == 0){ //bad pivots kept coming, heap sort caps it at O(N*Log(N))
+            heapSortRange(vec, low, high);
+            return;
+        }
+        depthLimit--;
+
+        choosePivot(vec, low, high);
+        int pivot = partition(vec, low, high, scheme);
+
+        if(pivot == low){ //nothing was smaller, so move every copy of the pivot next to it and skip them
+            int equal = low;
+            for(int j = low + 1; j <= high; j++){
+                if(!(vec[low] < vec[j]))
+                    std::swap(vec[++equal], vec[j]);
+            }
+            low = equal + 1;
+            continue;
+        }
+
+        //recurse on the smaller side and loop on the bigger one so the stack stays O(Log(N))
+        if(pivot - low < high - pivot){
+            introSortHelper(vec, low, pivot - 1, depthLimit, scheme);
+            low = pivot + 1;
+        }
+        else{
+            introSortHelper(vec, pivot + 1, high, depthLimit, scheme);
+            high = pivot - 1;
+        }
+    }
+    leafSort(vec, low, high);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::leafSort(std::vector<T>& vec, int low, int high){
+    if(high <= low)
+        return;
+    if constexpr(SimdSortingNetwork<T>::supported)
+        SimdSortingNetwork<T>::sort(&vec[low], high - low + 1);
+    else if(high - low < insertionThreshold)
+        networkSort(vec, low, high);
+    else
+        insertionSortRange(vec, low, high);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::networkSort(std::vector<T>& vec, int low, int high){
+    static_assert(insertionThreshold <= 16, "networkSort has cases up to 16");
+    T* data = &vec[low];
+    switch(high - low + 1){
+        case 2: SortingNetwork<2>::sort(data); break;
+        case 3: SortingNetwork<3>::sort(data); break;
+        case 4: SortingNetwork<4>::sort(data); break;
+        case 5: SortingNetwork<5>::sort(data); break;
+        case 6: SortingNetwork<6>::sort(data); break;
+        case 7: SortingNetwork<7>::sort(data); break;
+        case 8: SortingNetwork<8>::sort(data); break;
+        case 9: SortingNetwork<9>::sort(data); break;
+        case 10: SortingNetwork<10>::sort(data); break;
+        case 11: SortingNetwork<11>::sort(data); break;
+        case 12: SortingNetwork<12>::sort(data); break;
+        case 13: SortingNetwork<13>::sort(data); break;
+        case 14: SortingNetwork<14>::sort(data); break;
+        case 15: SortingNetwork<15>::sort(data); break;
+        case 16: SortingNetwork<16>::sort(data); break;
+        default: break;
+    }
+}
+
+template <typename T>
+void SortingAlgorithms<T>::choosePivot(std::vector<T>& vec, int low, int high){
+    int size = high - low + 1;
+    int mid = low + size / 2;
+    int median;
+    if(size > 128){ //ninther, median of the medians of three spread out triples
+        int step = size / 8;
+        int a = medianOfThree(vec, low, low + step, low + 2 * step);
+        int b = medianOfThree(vec, mid - step, mid, mid + step);
+        int c = medianOfThree(vec, high - 2 * step, high - step, high);
+        median = medianOfThree(vec, a, b, c);
+    }
+    else{
+        median = medianOfThree(vec, low, mid, high);
+    }
+    std::swap(vec[median], vec[high]);
+}
+
+template <typename T>
+int SortingAlgorithms<T>::medianOfThree(std::vector<T>& vec, int a, int b, int c){
+    if(vec[a] < vec[b]){
+        if(vec[b] < vec[c])
+            return b;
+        return vec[a] < vec[c] ? c : a;
+    }
+    if(vec[a] < vec[c])
+        return a;
+    return vec[b] < vec[c] ? c : b;
+}
+
+template <typename T>
+void SortingAlgorithms<T>::insertionSortRange(std::vector<T>& vec, int low, int high){
+    for(int i = low + 1; i <= high; i++){
+        T curr = std::move(vec[i]);
+        int j = i;
+        while(j > low && curr < vec[j-1]){
+            vec[j] = std::move(vec[j-1]);
+            j--;
+        }
+        vec[j] = std::move(curr);
+    }
+}
+
+template <typename T>
+void SortingAlgorithms<T>::heapSortRange(std::vector<T>& vec, int low, int high){
+    int size = high - low + 1;
+    for(int i = size / 2 - 1; i >= 0; i--){
+        siftDown(vec, low, i, size);
+    }
+
+    for(int end = size - 1; end > 0; end--){
+        T last = std::move(vec[low + end]);
+        vec[low + end] = std::move(vec[low]);
+
+        //Floyd: the old last element almost always belongs near the bottom, so walk the hole down to a leaf
+        //with one comparison per level, then sift the element back up the few levels it needs
+        int hole = 0;
+        int child = 1;
+        while(child < end){
+            if(child + 1 < end && vec[low + child] < vec[low + child + 1])
+                child++;
+            vec[low + hole] = std::move(vec[low + child]);
+            hole = child;
+            child = 2 * hole + 1;
+        }
+        while(hole > 0){
+            int parent = (hole - 1) / 2;
+            if(!(vec[low + parent] < last))
+                break;
+            vec[low + hole] = std::move(vec[low + parent]);
+            hole = parent;
+        }
+        vec[low + hole] = std::move(last);
+    }
+}
+
+template <typename T>
+void SortingAlgorithms<T>::siftDown(std::vector<T>& vec, int low, int root, int size){
+    T curr = std::move(vec[low + root]);
+    int child = 2 * root + 1;
+    while(child < size){
+        if(child + 1 < size && vec[low + child] < vec[low + child + 1])
+            child++;
+        if(!(curr < vec[low + child]))
+            break;
+        vec[low + root] = std::move(vec[low + child]);
+        root = child;
+        child = 2 * root + 1;
+    }
+    vec[low + root] = std::move(curr);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::radixSort(std::vector<T>& vec){
+    if constexpr(std::is_same_v<T, std::string>)
+        StringSort::sort(vec);
+    else
+        numericRadixSort(vec);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::numericRadixSort(std::vector<T>& vec){
+    static_assert((std::is_integral_v<T> || std::is_floating_point_v<T>) && !std::is_same_v<T, bool> && sizeof(T) <= 8,
+                  "radixSort needs an integer, float or double");
+    if(vec.size() < 2)
+        return;
+
+    constexpr unsigned int passes = sizeof(T);
+    size_t counts[passes][256] = {};
+    std::vector<RadixKey> keys(vec.size());
+    std::vector<RadixKey> buffer(vec.size());
+
+    //one read of the input fills the histograms of every digit
+    for(size_t i = 0; i < vec.size(); i++){
+        RadixKey key = radixKey(vec[i]);
+        keys[i] = key;
+        for(unsigned int pass = 0; pass < passes; pass++){
+            counts[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+    }
+
+    for(unsigned int pass = 0; pass < passes; pass++){
+        size_t* count = counts[pass];
+        unsigned int shift = pass * 8;
+        if(count[(keys[0] >> shift) & 0xFF] == keys.size()) //digit is the same everywhere
+            continue;
+
+        size_t offset = 0;
+        for(unsigned int digit = 0; digit < 256; digit++){
+            size_t curr = count[digit];
+            count[digit] = offset;
+            offset += curr;
+        }
+        for(RadixKey key : keys){
+            buffer[count[(key >> shift) & 0xFF]++] = key;
+        }
+        keys.swap(buffer);
+    }
+
+    for(size_t i = 0; i < vec.size(); i++){
+        vec[i] = radixValue(keys[i]);
+    }
+}
+
+template <typename T>
+typename SortingAlgorithms<T>::RadixKey SortingAlgorithms<T>::radixKey(T value){
+    constexpr RadixKey signBit = RadixKey(1) << (sizeof(T) * 8 - 1);
+    RadixKey bits = std::bit_cast<RadixKey>(value);
+    if constexpr(std::is_floating_point_v<T>)
+        return (bits & signBit) ? RadixKey(~bits) : RadixKey(bits | signBit);
+    else if constexpr(std::is_signed_v<T>)
+        return bits ^ signBit;
+    else
+        return bits;
+}
+
+template <typename T>
+T SortingAlgorithms<T>::radixValue(RadixKey key){
+    constexpr RadixKey signBit = RadixKey(1) << (sizeof(T) * 8 - 1);
+    if constexpr(std::is_floating_point_v<T>)
+        return std::bit_cast<T>((key & signBit) ? RadixKey(key ^ signBit) : RadixKey(~key));
+    else if constexpr(std::is_signed_v<T>)
+        return std::bit_cast<T>(RadixKey(key ^ signBit));
+    else
+        return std::bit_cast<T>(key);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::nthElement(std::vector<T>& vec, unsigned int n){
+    if(n >= vec.size())
+        throw std::out_of_range("Invalid index");
+
+    int low = 0;
+    int high = vec.size() - 1;
+    int depth = depthLimit(vec.size());
+    while(high - low + 1 > leafThreshold){
+        if(depth == 0){ //same guard as introSort, sorting what is left bounds the worst case
+            heapSortRange(vec, low, high);
+            return;
+        }
+        depth--;
+
+        choosePivot(vec, low, high);
+        int pivot = partition(vec, low, high, PartitionScheme::Block);
+
+        if(pivot == low){ //nothing smaller than the pivot, skip every copy of it at once
+            int equal = low;
+            for(int j = low + 1; j <= high; j++){
+                if(!(vec[low] < vec[j]))
+                    std::swap(vec[++equal], vec[j]);
+            }
+            if((int)n <= equal)
+                return;
+            low = equal + 1;
+            continue;
+        }
+
+        //only the side holding n is kept, which is what makes it linear
+        if((int)n == pivot)
+            return;
+        if((int)n < pivot)
+            high = pivot - 1;
+        else
+            low = pivot + 1;
+    }
+    leafSort(vec, low, high);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::partialSort(std::vector<T>& vec, unsigned int k){
+    k = std::min<size_t>(k, vec.size());
+    if(k == 0)
+        return;
+    if(k < vec.size())
+        nthElement(vec, k - 1);
+    introSortHelper(vec, 0, k - 1, depthLimit(k));
+}
+
+template <typename T>
+std::vector<T> SortingAlgorithms<T>::topK(std::vector<T>& vec, unsigned int k){
+    k = std::min<size_t>(k, vec.size());
+    if(k == 0)
+        return {};
+
+    //the k largest end up in the tail, which is the only part that gets sorted
+    int first = vec.size() - k;
+    nthElement(vec, first);
+    introSortHelper(vec, first, vec.size() - 1, depthLimit(k));
+    return std::vector<T>(vec.rbegin(), vec.rbegin() + k);
+}
+
+template <typename T>
+template <typename KeyFunction>
+std::vector<uint32_t> SortingAlgorithms<T>::argSort(const std::vector<T>& vec, KeyFunction key){
+    using Key = std::decay_t<std::invoke_result_t<KeyFunction&, const T&>>;
+
+    //the index is the second half of the pair so equal keys stay in input order
+    std::vector<std::pair<Key, uint32_t>> keyed;
+    keyed.reserve(vec.size());
+    for(uint32_t i = 0; i < vec.size(); i++){
+        keyed.emplace_back(key(vec[i]), i);
+    }
+    SortingAlgorithms<std::pair<Key, uint32_t>>::introSort(keyed);
+
+    std::vector<uint32_t> permutation(keyed.size());
+    for(size_t i = 0; i < keyed.size(); i++){
+        permutation[i] = keyed[i].second;
+    }
+    return permutation;
+}
+
+template <typename T>
+void SortingAlgorithms<T>::applyPermutation(std::vector<T>& vec, const std::vector<uint32_t>& permutation){
+    if(permutation.size() != vec.size())
+        throw std::invalid_argument("Permutation size does not match");
+
+    //a repeated or out of range index would send the cycle walk out of bounds or around forever
+    std::vector<bool> seen(vec.size(), false);
+    for(uint32_t index : permutation){
+        if(index >= vec.size() || seen[index])
+            throw std::invalid_argument("Permutation has a repeated or out of range index");
+        seen[index] = true;
+    }
+
+    std::vector<bool> placed(vec.size(), false);
+    for(size_t start = 0; start < vec.size(); start++){
+        if(placed[start])
+            continue;
+
+        //walk the cycle pulling each element into its slot, only the first one needs a temporary
+        T first = std::move(vec[start]);
+        size_t curr = start;
+        while(permutation[curr] != start){
+            vec[curr] = std::move(vec[permutation[curr]]);
+            placed[curr] = true;
+            curr = permutation[curr];
+        }
+        vec[curr] = std::move(first);
+        placed[curr] = true;
+    }
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelQuickSort(std::vector<T>& vec, unsigned int threads, int grain){
+    if(threads == 0){
+        parallelQuickSort(vec, ThreadPool::shared(), grain);
+        return;
+    }
+    ThreadPool pool(threads);
+    parallelQuickSort(vec, pool, grain);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelQuickSort(std::vector<T>& vec, ThreadPool& pool, int grain){
+    if(vec.size() < 2)
+        return;
+    TaskGroup group(pool);
+    parallelQuickSortHelper(vec, 0, vec.size() - 1, group, grain, depthLimit(vec.size()));
+    group.wait();
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelMergeSort(std::vector<T>& vec, unsigned int threads, int grain){
+    if(threads == 0){
+        parallelMergeSort(vec, ThreadPool::shared(), grain);
+        return;
+    }
+    ThreadPool pool(threads);
+    parallelMergeSort(vec, pool, grain);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelMergeSort(std::vector<T>& vec, ThreadPool& pool, int grain){
+    if(vec.size() < 2)
+        return;
+    grain = std::max(grain, insertionThreshold);
+    //one buffer for the whole sort, the levels alternate between it and vec
+    std::vector<T> buffer(vec.size());
+    parallelMergeHelper(vec, buffer.data(), 0, vec.size(), false, pool, grain);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelSampleSort(std::vector<T>& vec, unsigned int threads, int grain){
+    if(threads == 0){
+        parallelSampleSort(vec, ThreadPool::shared(), grain);
+        return;
+    }
+    ThreadPool pool(threads);
+    parallelSampleSort(vec, pool, grain);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelSampleSort(std::vector<T>& vec, ThreadPool& pool, int grain){
+    //grain divides the size below, so it is clamped once here for every use
+    grain = std::max(grain, 1);
+    size_t size = vec.size();
+    if(size < 2 * (size_t)grain || size >= (size_t)std::numeric_limits<int>::max()){
+        introSort(vec);
+        return;
+    }
+
+    unsigned int workers = pool.size();
+    //power of two buckets so the splitter tree is complete, aiming for grain elements each
+    unsigned int buckets = std::bit_ceil<size_t>(std::clamp<size_t>(size / grain, 2, maxBuckets));
+    unsigned int levels = std::countr_zero(buckets);
+
+    //sorted random sample, every oversampling-th element becomes a splitter
+    std::vector<T> sample;
+    sample.reserve(buckets * oversampling);
+    uint64_t state = 0x9E3779B97F4A7C15ull ^ size;
+    for(unsigned int i = 0; i < buckets * oversampling; i++){
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        sample.push_back(vec[(state >> 33) % size]);
+    }
+    introSort(sample);
+    std::vector<T> splitters;
+    for(unsigned int i = 1; i < buckets; i++){
+        splitters.push_back(sample[i * oversampling]);
+    }
+
+    //a key common enough to be picked as two neighbouring splitters would fill whole buckets that introsort then
+    //only rearranges, so every distinct splitter gets a bucket for the keys equal to it that is already sorted,
+    //put before the bucket of keys above it, and the splitters are thinned so twice the buckets still fit in a byte
+    auto same = [](const T& a, const T& b){ return !(a < b) && !(b < a); };
+    bool equalBuckets = std::adjacent_find(splitters.begin(), splitters.end(), same) != splitters.end();
+    if(equalBuckets){
+        splitters.erase(std::unique(splitters.begin(), splitters.end(), same), splitters.end());
+        size_t distinct = std::min<size_t>(splitters.size(), maxBuckets / 2 - 1);
+        std::vector<T> kept;
+        for(size_t i = 0; i < distinct; i++)
+            kept.push_back(splitters[i * splitters.size() / distinct]);
+        buckets = std::bit_ceil(distinct + 1);
+        levels = std::countr_zero(buckets);
+        //repeating the largest splitter leaves the buckets between it and the last one empty
+        kept.resize(buckets - 1, kept.back());
+        splitters = std::move(kept);
+    }
+    unsigned int slots = equalBuckets ? 2 * buckets : buckets;
+    std::vector<T> tree(buckets);
+    unsigned int next = 0;
+    buildSplitterTree(splitters, tree, 1, next);
+
+    //phase 1: every thread classifies its slice and counts its buckets
+    std::vector<uint8_t> bucketOf(size);
+    std::vector<std::vector<size_t>> counts(workers, std::vector<size_t>(slots, 0));
+    {
+        TaskGroup group(pool);
+        for(unsigned int t = 0; t < workers; t++){
+            group.run([&, t]{
+                size_t begin = size * t / workers;
+                size_t end = size * (t + 1) / workers;
+                std::vector<size_t>& count = counts[t];
+                for(size_t i = begin; i < end; i++){
+                    //descend the tree with the comparison as the next bit, so there is no branch to mispredict
+                    unsigned int node = 1;
+                    for(unsigned int l = 0; l < levels; l++)
+                        node = 2 * node + !(vec[i] < tree[node]);
+                    unsigned int bucket = node - buckets;
+                    //the key is at least the splitter below its bucket, so not being above it means equal
+                    if(equalBuckets)
+                        bucket = 2 * bucket + 1 - (bucket != 0 && !(splitters[bucket - 1] < vec[i]));
+                    bucketOf[i] = bucket;
+                    count[bucket]++;
+                }
+            });
+        }
+        group.wait();
+    }
+
+    //one prefix sum, bucket major then thread, gives every thread its own write position in every bucket
+    std::vector<size_t> bucketStart(slots + 1);
+    size_t offset = 0;
+    for(unsigned int b = 0; b < slots; b++){
+        bucketStart[b] = offset;
+        for(unsigned int t = 0; t < workers; t++){
+            size_t count = counts[t][b];
+            counts[t][b] = offset;
+            offset += count;
+        }
+    }
+    bucketStart[slots] = size;
+
+    //phase 2: every thread moves its slice into place in the buffer, the write ranges never overlap
+    std::vector<T> buffer(size);
+    {
+        TaskGroup group(pool);
+        for(unsigned int t = 0; t < workers; t++){
+            group.run([&, t]{
+                size_t begin = size * t / workers;
+                size_t end = size * (t + 1) / workers;
+                std::vector<size_t>& position = counts[t];
+                for(size_t i = begin; i < end; i++)
+                    buffer[position[bucketOf[i]]++] = std::move(vec[i]);
+            });
+        }
+        group.wait();
+    }
+
+    //phase 3: buckets are independent, each is moved back and sorted by whichever thread takes it
+    TaskGroup group(pool);
+    for(unsigned int b = 0; b < slots; b++){
+        int low = bucketStart[b];
+        int high = bucketStart[b + 1] - 1;
+        if(high < low)
+            continue;
+        bool sorted = equalBuckets && b % 2 == 0;
+        group.run([&vec, &buffer, low, high, sorted]{
+            std::move(buffer.begin() + low, buffer.begin() + high + 1, vec.begin() + low);
+            if(low < high && !sorted)
+                introSortHelper(vec, low, high, depthLimit(high - low + 1));
+        });
+    }
+    group.wait();
+}
+
+template <typename T>
+void SortingAlgorithms<T>::buildSplitterTree(const std::vector<T>& splitters, std::vector<T>& tree, unsigned int node, unsigned int& next){
+    //in order walk, so the left subtree of a node only holds smaller splitters
+    if(node >= tree.size())
+        return;
+    buildSplitterTree(splitters, tree, 2 * node, next);
+    tree[node] = splitters[next++];
+    buildSplitterTree(splitters, tree, 2 * node + 1, next);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelQuickSortHelper(std::vector<T>& vec, int low, int high, TaskGroup& group, int grain, int depth){
+    //keep splitting the right side on this thread, the left side becomes a task others can steal
+    while(high - low + 1 > grain && depth > 0){
+        depth--;
+        choosePivot(vec, low, high);
+        int pivot = partition(vec, low, high, PartitionScheme::Block);
+        int leftHigh = pivot - 1;
+        group.run([&vec, &group, low, leftHigh, grain, depth]{
+            parallelQuickSortHelper(vec, low, leftHigh, group, grain, depth);
+        });
+        low = pivot + 1;
+    }
+    if(low < high)
+        introSortHelper(vec, low, high, depth);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelMergeHelper(std::vector<T>& vec, T* buffer, size_t begin, size_t end, bool intoBuffer,
+                                               ThreadPool& pool, int grain){
+    if(end - begin <= (size_t)grain){
+        bottomUpMergeRange(vec, buffer, begin, end);
+        if(intoBuffer)
+            std::move(vec.begin() + begin, vec.begin() + end, buffer + begin);
+        return;
+    }
+
+    //the halves are sorted into the other array so the merge lands where this level was asked for
+    size_t mid = begin + (end - begin) / 2;
+    {
+        //both halves have to be done before merging, the wait helps run queued tasks
+        TaskGroup group(pool);
+        group.run([&vec, buffer, &pool, begin, mid, intoBuffer, grain]{
+            parallelMergeHelper(vec, buffer, begin, mid, !intoBuffer, pool, grain);
+        });
+        parallelMergeHelper(vec, buffer, mid, end, !intoBuffer, pool, grain);
+        group.wait();
+    }
+    if(intoBuffer)
+        parallelMergeInto(vec.data(), buffer, begin, mid, end, pool, grain);
+    else
+        parallelMergeInto(buffer, vec.data(), begin, mid, end, pool, grain);
+}
+
+template <typename T>
+void SortingAlgorithms<T>::parallelMergeInto(T* src, T* dst, size_t begin, size_t mid, size_t end, ThreadPool& pool, int grain){
+    //a few chunks per thread so a slow one does not hold up the rest, the top merge alone is O(N)
+    size_t chunks = std::min<size_t>(pool.size() * 4, (end - begin) / grain);
+    if(chunks < 2){
+        mergeInto(src, dst, begin, mid, end);
+        return;
+    }
+
+    T* left = src + begin;
+    T* right = src + mid;
+    size_t leftSize = mid - begin;
+    size_t rightSize = end - mid;
+    TaskGroup group(pool);
+    for(size_t c = 0; c < chunks; c++){
+        group.run([=]{
+            size_t first = (end - begin) * c / chunks;
+            size_t last = (end - begin) * (c + 1) / chunks;
+            size_t leftFirst = coRank(left, leftSize, right, rightSize, first);
+            size_t leftLast = coRank(left, leftSize, right, rightSize, last);
+            mergeSpans(left + leftFirst, left + leftLast, right + (first - leftFirst), right + (last - leftLast),
+                       dst + begin + first);
+        });
+    }
+    group.wait();
+}
+
+template <typename T>
+size_t SortingAlgorithms<T>::coRank(const T* left, size_t leftSize, const T* right, size_t rightSize, size_t rank){
+    size_t low = rank > rightSize ? rank - rightSize : 0;
+    size_t high = std::min(rank, leftSize);
+    while(low < high){
+        //take i from the left, then left[i] belongs in the first rank outputs if it does not come after right[rank-i-1]
+        size_t i = low + (high - low) / 2;
+        if(!(right[rank - i - 1] < left[i]))
+            low = i + 1;
+        else
+            high = i;
     }
+    return low;
 }
 #endif
\ No newline at end of file
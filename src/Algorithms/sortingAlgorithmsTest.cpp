@@ -0,0 +1,58 @@
+#include "sortingAlgorithms.hpp"
+#include "../check.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+int main(){
+    //permutations with a repeated or out of range index are rejected instead of looping or reading out of bounds
+    for(const std::vector<uint32_t>& permutation : {std::vector<uint32_t>{0, 1, 1}, std::vector<uint32_t>{0, 3, 1}}){
+        std::vector<float> vec = {1, 2, 3};
+        check::throws<std::invalid_argument>([&]{ SortingAlgorithms<float>::applyPermutation(vec, permutation); },
+                                             "applyPermutation accepted an invalid permutation");
+    }
+    std::vector<float> vec = {30, 10, 20};
+    SortingAlgorithms<float>::applyPermutation(vec, SortingAlgorithms<float>::argSort(vec, [](float x){ return x; }));
+    check::that(vec == std::vector<float>{10, 20, 30}, "applyPermutation of argSort sorts");
+
+    //a grain of 0 or below is treated as 1 instead of dividing by it
+    for(int grain : {0, -5}){
+        std::mt19937 rng(grain + 10);
+        std::uniform_real_distribution<float> uniform(0, 1);
+        std::vector<float> vec(1000);
+        for(float& value : vec)
+            value = uniform(rng);
+        SortingAlgorithms<float>::parallelSampleSort(vec, 2, grain);
+        check::that(std::is_sorted(vec.begin(), vec.end()), "parallelSampleSort with a grain of 0 or below");
+    }
+
+    //one pool the caller keeps serves every sort, both on its own and on the shared pool
+    ThreadPool pool(2);
+    std::mt19937 rng(7);
+    for(int round = 0; round < 3; round++){
+        std::vector<int> input(50000);
+        for(int& value : input)
+            value = rng() % 1000;
+        std::vector<int> quick = input, merge = input, shared = input;
+        SortingAlgorithms<int>::parallelQuickSort(quick, pool, 1000);
+        SortingAlgorithms<int>::parallelMergeSort(merge, pool, 1000);
+        SortingAlgorithms<int>::parallelQuickSort(shared, 0, 1000);
+        check::that(std::is_sorted(quick.begin(), quick.end()), "parallelQuickSort on a kept pool");
+        check::that(std::is_sorted(merge.begin(), merge.end()), "parallelMergeSort on a kept pool");
+        check::that(std::is_sorted(shared.begin(), shared.end()), "parallelQuickSort on the shared pool");
+    }
+
+    //few distinct keys, or one key taking half the input, pick equal neighbouring splitters and use equality buckets
+    for(int round = 0; round < 4; round++){
+        std::vector<int> vec(100000);
+        for(int& value : vec)
+            value = round < 2 ? rng() % (round * 3 + 2) : rng() % 2 ? 7 : rng() % 100000;
+        std::vector<int> expected = vec;
+        std::sort(expected.begin(), expected.end());
+        SortingAlgorithms<int>::parallelSampleSort(vec, pool, 1000);
+        check::that(vec == expected, "parallelSampleSort with repeated splitters");
+    }
+    return check::failures();
+}
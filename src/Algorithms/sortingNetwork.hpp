@@ -0,0 +1,226 @@
+#ifndef SORTING_NETWORK
+#define SORTING_NETWORK
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/// @brief One compare exchange of a sorting network, the smaller value ends up at first
+struct Comparator{
+    unsigned char first;
+    unsigned char second;
+};
+
+/// @brief Sorting network for N elements, built at compile time and unrolled into straight line code
+/// N up to 16 uses the best known networks, proven optimal up to 12, bigger N uses Batcher's odd even merge sort
+/// @tparam N Number of elements, at most 32
+template <size_t N>
+class SortingNetwork{
+    public:
+        static_assert(N <= 32, "SortingNetwork is meant for small fixed sizes");
+
+        /// @brief Sorts the array in place, usable in constant expressions
+        template <typename T>
+        static constexpr void sort(std::array<T, N>& arr);
+
+        /// @brief Sorts data[0, N) in place, usable in constant expressions
+        template <typename T>
+        static constexpr void sort(T* data);
+
+    private:
+        /// @brief Best known networks, fewest comparators for their size
+        /// 15 is the 16 element one with the comparators on its last wire dropped, which still has the fewest known
+        static constexpr auto optimalNetwork();
+
+        /// @brief Runs Batcher's odd even merge sort on N positions, writing the comparators to out if it is not null
+        /// @return Returns the number of comparators
+        static constexpr size_t batcher(Comparator* out);
+
+        static constexpr auto makeNetwork();
+
+    public:
+        /// @brief Comparators in the order they are applied
+        static constexpr auto comparators = makeNetwork();
+
+        /// @brief Number of compare exchanges per sort
+        static constexpr size_t size = comparators.size();
+
+    private:
+        /// @brief Checks the network sorts all 2^N inputs of 0s and 1s, which by the 0-1 principle means it sorts anything
+        /// Runs at compile time, so it is only used up to the 2^16 inputs of the typed in tables
+        static constexpr bool zeroOneCheck();
+
+        //the tables are typed in by hand, so they are checked when the network is instantiated
+        static_assert(N > 16 || zeroOneCheck(), "Sorting network table is wrong");
+
+        template <typename T, size_t... I>
+        static constexpr void apply(T* data, std::index_sequence<I...>);
+
+        /// @brief Branchless for arithmetic types, a conditional swap for everything else
+        template <typename T>
+        static constexpr void compareExchange(T& a, T& b);
+};
+
+template <size_t N>
+template <typename T>
+constexpr void SortingNetwork<N>::sort(std::array<T, N>& arr){
+    sort(arr.data());
+}
+
+template <size_t N>
+template <typename T>
+constexpr void SortingNetwork<N>::sort(T* data){
+    apply(data, std::make_index_sequence<size>{});
+}
+
+template <size_t N>
+template <typename T, size_t... I>
+constexpr void SortingNetwork<N>::apply(T* data, std::index_sequence<I...>){
+    //every index is a constant, so this expands to size compare exchanges with no loop
+    (compareExchange(data[comparators[I].first], data[comparators[I].second]), ...);
+}
+
+template <size_t N>
+template <typename T>
+constexpr void SortingNetwork<N>::compareExchange(T& a, T& b){
+    if constexpr(std::is_arithmetic_v<T>){
+        //both selects become min/max or conditional moves
+        T low = b < a ? b : a;
+        T high = b < a ? a : b;
+        a = low;
+        b = high;
+    }
+    else{
+        if(b < a)
+            std::swap(a, b);
+    }
+}
+
+template <size_t N>
+constexpr auto SortingNetwork<N>::optimalNetwork(){
+    if constexpr(N == 2)
+        return std::array<Comparator, 1>{{{0,1}}};
+    else if constexpr(N == 3)
+        return std::array<Comparator, 3>{{{0,2}, {0,1}, {1,2}}};
+    else if constexpr(N == 4)
+        return std::array<Comparator, 5>{{{0,2}, {1,3}, {0,1}, {2,3}, {1,2}}};
+    else if constexpr(N == 5)
+        return std::array<Comparator, 9>{{{0,3}, {1,4}, {0,2}, {1,3}, {0,1}, {2,4}, {1,2}, {3,4}, {2,3}}};
+    else if constexpr(N == 6)
+        return std::array<Comparator, 12>{{{0,5}, {1,3}, {2,4}, {1,2}, {3,4}, {0,3}, {2,5}, {0,1}, {2,3}, {4,5},
+                                           {1,2}, {3,4}}};
+    else if constexpr(N == 7)
+        return std::array<Comparator, 16>{{{0,6}, {2,3}, {4,5}, {0,2}, {1,4}, {3,6}, {0,1}, {2,5}, {3,4}, {1,2},
+                                           {4,6}, {2,3}, {4,5}, {1,2}, {3,4}, {5,6}}};
+    else if constexpr(N == 8)
+        return std::array<Comparator, 19>{{{0,2}, {1,3}, {4,6}, {5,7}, {0,4}, {1,5}, {2,6}, {3,7}, {0,1}, {2,3},
+                                           {4,5}, {6,7}, {2,4}, {3,5}, {1,4}, {3,6}, {1,2}, {3,4}, {5,6}}};
+    else if constexpr(N == 9)
+        return std::array<Comparator, 25>{{{0,3}, {1,7}, {2,5}, {4,8}, {0,7}, {2,4}, {3,8}, {5,6}, {0,2}, {1,3},
+                                           {4,5}, {7,8}, {1,4}, {3,6}, {5,7}, {0,1}, {2,4}, {3,5}, {6,8}, {2,3},
+                                           {4,5}, {6,7}, {1,2}, {3,4}, {5,6}}};
+    else if constexpr(N == 10)
+        return std::array<Comparator, 29>{{{0,8}, {1,9}, {2,7}, {3,5}, {4,6}, {0,2}, {1,4}, {5,8}, {7,9}, {0,3},
+                                           {2,4}, {5,7}, {6,9}, {0,1}, {3,6}, {8,9}, {1,5}, {2,3}, {4,8}, {6,7},
+                                           {1,2}, {3,5}, {4,6}, {7,8}, {2,3}, {4,5}, {6,7}, {3,4}, {5,6}}};
+    else if constexpr(N == 11)
+        return std::array<Comparator, 35>{{{0,9}, {1,6}, {2,4}, {3,7}, {5,8}, {0,1}, {3,5}, {4,10}, {6,9}, {7,8},
+                                           {1,3}, {2,5}, {4,7}, {8,10}, {0,4}, {1,2}, {3,7}, {5,9}, {6,8}, {0,1},
+                                           {2,6}, {4,5}, {7,8}, {9,10}, {2,4}, {3,6}, {5,7}, {8,9}, {1,2}, {3,4},
+                                           {5,6}, {7,8}, {2,3}, {4,5}, {6,7}}};
+    else if constexpr(N == 12)
+        return std::array<Comparator, 39>{{{0,8}, {1,7}, {2,6}, {3,11}, {4,10}, {5,9}, {0,1}, {2,5}, {3,4}, {6,9},
+                                           {7,8}, {10,11}, {0,2}, {1,6}, {5,10}, {9,11}, {0,3}, {1,2}, {4,6}, {5,7},
+                                           {8,11}, {9,10}, {1,4}, {3,5}, {6,8}, {7,10}, {1,3}, {2,5}, {6,9}, {8,10},
+                                           {2,3}, {4,5}, {6,7}, {8,9}, {4,6}, {5,7}, {3,4}, {5,6}, {7,8}}};
+    else if constexpr(N == 13)
+        return std::array<Comparator, 45>{{{0,12}, {1,10}, {2,9}, {3,7}, {5,11}, {6,8}, {1,6}, {2,3}, {4,11}, {7,9},
+                                           {8,10}, {0,4}, {1,2}, {3,6}, {7,8}, {9,10}, {11,12}, {4,6}, {5,9}, {8,11},
+                                           {10,12}, {0,5}, {3,8}, {4,7}, {6,11}, {9,10}, {0,1}, {2,5}, {6,9}, {7,8},
+                                           {10,11}, {1,3}, {2,4}, {5,6}, {9,10}, {1,2}, {3,4}, {5,7}, {6,8}, {2,3},
+                                           {4,5}, {6,7}, {8,9}, {3,4}, {5,6}}};
+    else if constexpr(N == 14)
+        return std::array<Comparator, 51>{{{0,1}, {2,3}, {4,5}, {6,7}, {8,9}, {10,11}, {12,13}, {0,2}, {1,3}, {4,8},
+                                           {5,9}, {10,12}, {11,13}, {0,4}, {1,2}, {3,7}, {5,8}, {6,10}, {9,13},
+                                           {11,12}, {0,6}, {1,5}, {3,9}, {4,10}, {7,13}, {8,12}, {2,10}, {3,11},
+                                           {4,6}, {7,9}, {1,3}, {2,8}, {5,11}, {6,7}, {10,12}, {1,4}, {2,6}, {3,5},
+                                           {7,11}, {8,10}, {9,12}, {2,4}, {3,6}, {5,8}, {7,10}, {9,11}, {3,4}, {5,6},
+                                           {7,8}, {9,10}, {6,7}}};
+    else if constexpr(N == 15)
+        return std::array<Comparator, 56>{{{0,13}, {1,12}, {3,14}, {4,8}, {5,6}, {7,11}, {9,10}, {0,5}, {1,7}, {2,9},
+                                           {3,4}, {6,13}, {8,14}, {11,12}, {0,1}, {2,3}, {4,5}, {6,8}, {7,9},
+                                           {10,11}, {12,13}, {0,2}, {1,3}, {4,10}, {5,11}, {6,7}, {8,9}, {12,14},
+                                           {1,2}, {3,12}, {4,6}, {5,7}, {8,10}, {9,11}, {13,14}, {1,4}, {2,6}, {5,8},
+                                           {7,10}, {9,13}, {11,14}, {2,4}, {3,6}, {9,12}, {11,13}, {3,5}, {6,8},
+                                           {7,9}, {10,12}, {3,4}, {5,6}, {7,8}, {9,10}, {11,12}, {6,7}, {8,9}}};
+    else
+        return std::array<Comparator, 60>{{{0,13}, {1,12}, {2,15}, {3,14}, {4,8}, {5,6}, {7,11}, {9,10}, {0,5},
+                                           {1,7}, {2,9}, {3,4}, {6,13}, {8,14}, {10,15}, {11,12}, {0,1}, {2,3},
+                                           {4,5}, {6,8}, {7,9}, {10,11}, {12,13}, {14,15}, {0,2}, {1,3}, {4,10},
+                                           {5,11}, {6,7}, {8,9}, {12,14}, {13,15}, {1,2}, {3,12}, {4,6}, {5,7},
+                                           {8,10}, {9,11}, {13,14}, {1,4}, {2,6}, {5,8}, {7,10}, {9,13}, {11,14},
+                                           {2,4}, {3,6}, {9,12}, {11,13}, {3,5}, {6,8}, {7,9}, {10,12}, {3,4}, {5,6},
+                                           {7,8}, {9,10}, {11,12}, {6,7}, {8,9}}};
+}
+
+template <size_t N>
+constexpr size_t SortingNetwork<N>::batcher(Comparator* out){
+    size_t count = 0;
+    for(size_t p = 1; p < N; p <<= 1){
+        for(size_t k = p; k >= 1; k >>= 1){
+            for(size_t j = k % p; j + k < N; j += 2 * k){
+                for(size_t i = 0; i < k && i + j + k < N; i++){
+                    //only pairs inside the same block of 2p being merged are compared
+                    if((i + j) / (2 * p) == (i + j + k) / (2 * p)){
+                        if(out)
+                            out[count] = {(unsigned char)(i + j), (unsigned char)(i + j + k)};
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+template <size_t N>
+constexpr auto SortingNetwork<N>::makeNetwork(){
+    if constexpr(N < 2){
+        return std::array<Comparator, 0>{};
+    }
+    else if constexpr(N <= 16){
+        return optimalNetwork();
+    }
+    else{
+        std::array<Comparator, batcher(nullptr)> network{};
+        batcher(network.data());
+        return network;
+    }
+}
+
+template <size_t N>
+constexpr bool SortingNetwork<N>::zeroOneCheck(){
+    //bit sliced, every wire holds its bit of 64 inputs at once, so a compare exchange is one and plus one or
+    constexpr unsigned long long lanes[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+                                             0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+    for(unsigned long long base = 0; base < (1ull << N); base += 64){
+        //with fewer than 6 wires the lanes past 2^N just repeat the same inputs
+        std::array<unsigned long long, N> wires{};
+        for(size_t w = 0; w < N; w++)
+            wires[w] = w < 6 ? lanes[w] : (base >> w & 1) ? ~0ull : 0;
+        for(const Comparator& c : comparators){
+            unsigned long long low = wires[c.first] & wires[c.second];
+            wires[c.second] |= wires[c.first];
+            wires[c.first] = low;
+        }
+        //sorted means no input has a 1 on a wire and a 0 on the one after
+        for(size_t w = 0; w + 1 < N; w++){
+            if(wires[w] & ~wires[w + 1])
+                return false;
+        }
+    }
+    return true;
+}
+
+#endif
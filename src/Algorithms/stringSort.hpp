@@ -0,0 +1,254 @@
+#ifndef STRING_SORT
+#define STRING_SORT
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// @brief Sorts for strings that look at every character of a shared prefix once instead of on every comparison
+/// Both sorts work on small entries holding a pointer to the characters and the next eight of them, so partitioning
+/// never follows the pointer and the strings themselves are moved once at the end
+class StringSort{
+    public:
+
+        /// @brief MSD radix sort on bytes, O(D + N*Log(alphabet)) where D is the number of distinguishing characters
+        /// Buckets that fit in cache go to multikey quick sort and tiny ones to insertion sort from the current depth
+        static void sort(std::vector<std::string>& vec);
+
+        /// @brief Bentley and Sedgewick's three way radix quick sort, partitions on the next characters
+        /// and only moves past them for the strings equal to the pivot so far
+        /// Eight characters are compared at once as one 64 bit digit so long shared prefixes are skipped quickly
+        static void multikeyQuickSort(std::vector<std::string>& vec);
+
+    private:
+        /// @brief String with the eight characters from the current depth cached
+        struct Entry{
+            //the characters are pointed to directly, going through the std::string would be a second cache miss
+            const char* data;
+            //big endian so comparing the integers compares the characters in order, zero padded past the end
+            uint64_t bytes;
+            //characters left from depth, capped at 9 which means the string goes on past the cached ones
+            uint32_t length;
+            //position in the input, where the string is moved from at the end
+            uint32_t index;
+            size_t size;
+        };
+
+        /// @brief Buckets smaller than this are left to multikey quick sort, the 257 counters stop paying off
+        static constexpr size_t radixThreshold = 1 << 12;
+
+        /// @brief Ranges smaller than this are finished with insertion sort
+        static constexpr size_t insertionThreshold = 16;
+
+        /// @brief Makes an entry for every string with the characters from depth 0 cached
+        static std::vector<Entry> makeEntries(const std::vector<std::string>& vec);
+
+        /// @brief Moves the strings into the order of the sorted entries
+        static void applyEntries(std::vector<std::string>& vec, const std::vector<Entry>& entries);
+
+        /// @brief Reads the eight characters at depth into the entries of [low, high)
+        static void cache(std::vector<Entry>& entries, size_t low, size_t high, size_t depth);
+
+        /// @brief Gets the cached character at offset as 1 to 256, or 0 past the end so shorter strings come first
+        static unsigned int charAt(const Entry& entry, unsigned int offset);
+
+        /// @brief Compares the cached characters, then the lengths so a shorter string comes first
+        static bool chunkLess(const Entry& a, const Entry& b);
+
+        /// @brief Sorts [low, high) whose entries share their first depth+offset characters and have depth cached
+        /// @param buffer Scratch space at least as big as the input, entries are distributed into it
+        static void msdRadixHelper(std::vector<Entry>& entries, size_t low, size_t high, size_t depth, unsigned int offset,
+                                   std::vector<Entry>& buffer);
+
+        /// @brief Sorts [low, high) whose entries share their first depth characters and have depth cached
+        static void multikeyHelper(std::vector<Entry>& entries, size_t low, size_t high, size_t depth);
+
+        /// @brief Insertion sort of [low, high) on the cached characters, then the rest of the strings
+        static void insertionSortFrom(std::vector<Entry>& entries, size_t low, size_t high, size_t depth);
+};
+
+inline void StringSort::sort(std::vector<std::string>& vec){
+    if(vec.size() < 2)
+        return;
+    std::vector<Entry> entries = makeEntries(vec);
+    if(vec.size() < radixThreshold){
+        multikeyHelper(entries, 0, entries.size(), 0);
+    }
+    else{
+        std::vector<Entry> buffer(entries.size());
+        msdRadixHelper(entries, 0, entries.size(), 0, 0, buffer);
+    }
+    applyEntries(vec, entries);
+}
+
+inline void StringSort::multikeyQuickSort(std::vector<std::string>& vec){
+    if(vec.size() < 2)
+        return;
+    std::vector<Entry> entries = makeEntries(vec);
+    multikeyHelper(entries, 0, entries.size(), 0);
+    applyEntries(vec, entries);
+}
+
+inline std::vector<StringSort::Entry> StringSort::makeEntries(const std::vector<std::string>& vec){
+    std::vector<Entry> entries(vec.size());
+    for(size_t i = 0; i < vec.size(); i++){
+        entries[i].data = vec[i].data();
+        entries[i].size = vec[i].size();
+        entries[i].index = i;
+    }
+    cache(entries, 0, entries.size(), 0);
+    return entries;
+}
+
+inline void StringSort::applyEntries(std::vector<std::string>& vec, const std::vector<Entry>& entries){
+    std::vector<std::string> sorted;
+    sorted.reserve(vec.size());
+    for(const Entry& entry : entries)
+        sorted.push_back(std::move(vec[entry.index]));
+    vec.swap(sorted);
+}
+
+inline void StringSort::cache(std::vector<Entry>& entries, size_t low, size_t high, size_t depth){
+    //entries are in sorted order by now, so every string is a cache miss, a few are kept in flight
+    constexpr size_t ahead = 8;
+    for(size_t i = low; i < high; i++){
+        if(i + ahead < high)
+            __builtin_prefetch(entries[i + ahead].data + depth);
+        Entry& entry = entries[i];
+        size_t left = depth < entry.size ? entry.size - depth : 0;
+        unsigned char raw[8] = {};
+        std::memcpy(raw, entry.data + std::min(depth, entry.size), std::min<size_t>(left, 8));
+        uint64_t bytes = 0;
+        for(unsigned int b = 0; b < 8; b++)
+            bytes = bytes << 8 | raw[b];
+        entry.bytes = bytes;
+        entry.length = std::min<size_t>(left, 9);
+    }
+}
+
+inline unsigned int StringSort::charAt(const Entry& entry, unsigned int offset){
+    return offset < entry.length ? (unsigned int)(entry.bytes >> (56 - 8 * offset) & 0xff) + 1 : 0;
+}
+
+inline bool StringSort::chunkLess(const Entry& a, const Entry& b){
+    return a.bytes < b.bytes || (a.bytes == b.bytes && a.length < b.length);
+}
+
+inline void StringSort::msdRadixHelper(std::vector<Entry>& entries, size_t low, size_t high, size_t depth, unsigned int offset,
+                                       std::vector<Entry>& buffer){
+    while(true){
+        if(high - low < radixThreshold){
+            //multikey quick sort compares whole chunks, the characters before offset are equal so they do not matter
+            multikeyHelper(entries, low, high, depth);
+            return;
+        }
+
+        //characters every string shares are skipped in one pass instead of a counting pass each
+        uint64_t differ = 0;
+        uint32_t shortest = 9;
+        for(size_t i = low; i < high; i++){
+            differ |= entries[i].bytes ^ entries[low].bytes;
+            shortest = std::min(shortest, entries[i].length);
+        }
+        unsigned int shared = std::min<unsigned int>(differ ? std::countl_zero(differ) / 8 : 8, shortest);
+        offset = std::max(offset, shared);
+        if(offset < 8)
+            break;
+
+        //every cached character is used up, read the next eight
+        depth += 8;
+        offset = 0;
+        cache(entries, low, high, depth);
+    }
+
+    size_t counts[257] = {};
+    for(size_t i = low; i < high; i++)
+        counts[charAt(entries[i], offset)]++;
+
+    //a character every string shares only deepens the prefix, nothing has to move
+    unsigned int first = charAt(entries[low], offset);
+    if(counts[first] == high - low){
+        if(first != 0)
+            msdRadixHelper(entries, low, high, depth, offset + 1, buffer);
+        return;
+    }
+
+    size_t starts[258];
+    starts[0] = low;
+    for(unsigned int c = 0; c < 257; c++)
+        starts[c + 1] = starts[c] + counts[c];
+
+    size_t next[257];
+    std::copy(starts, starts + 257, next);
+    for(size_t i = low; i < high; i++)
+        buffer[next[charAt(entries[i], offset)]++] = entries[i];
+    std::copy(buffer.begin() + low, buffer.begin() + high, entries.begin() + low);
+
+    //bucket 0 holds the strings that ended here, they are all equal
+    for(unsigned int c = 1; c < 257; c++){
+        if(starts[c + 1] - starts[c] > 1)
+            msdRadixHelper(entries, starts[c], starts[c + 1], depth, offset + 1, buffer);
+    }
+}
+
+inline void StringSort::multikeyHelper(std::vector<Entry>& entries, size_t low, size_t high, size_t depth){
+    while(high - low > insertionThreshold){
+        //median of three chunks as the pivot
+        size_t mid = low + (high - low) / 2;
+        const Entry& a = entries[low];
+        const Entry& b = entries[mid];
+        const Entry& c = entries[high - 1];
+        Entry pivot = chunkLess(a, b) ? (chunkLess(b, c) ? b : (chunkLess(a, c) ? c : a))
+                                      : (chunkLess(a, c) ? a : (chunkLess(b, c) ? c : b));
+
+        //three way partition on the cached chunk: [low, lt) smaller, [lt, gt) equal, [gt, high) greater
+        size_t lt = low;
+        size_t gt = high;
+        size_t i = low;
+        while(i < gt){
+            if(chunkLess(entries[i], pivot))
+                std::swap(entries[lt++], entries[i++]);
+            else if(chunkLess(pivot, entries[i]))
+                std::swap(entries[i], entries[--gt]);
+            else
+                i++;
+        }
+
+        multikeyHelper(entries, low, lt, depth);
+        multikeyHelper(entries, gt, high, depth);
+
+        //the equal part shares eight more characters, unless they all ended inside this chunk
+        if(pivot.length <= 8)
+            return;
+        low = lt;
+        high = gt;
+        depth += 8;
+        cache(entries, low, high, depth);
+    }
+    insertionSortFrom(entries, low, high, depth);
+}
+
+inline void StringSort::insertionSortFrom(std::vector<Entry>& entries, size_t low, size_t high, size_t depth){
+    //only strings equal in the cached chunk and longer than it need their characters past it compared
+    auto less = [depth](const Entry& a, const Entry& b){
+        if(a.bytes != b.bytes || a.length != b.length || a.length <= 8)
+            return chunkLess(a, b);
+        return std::string_view(a.data + depth + 8, a.size - depth - 8) < std::string_view(b.data + depth + 8, b.size - depth - 8);
+    };
+    for(size_t i = low + 1; i < high; i++){
+        Entry curr = entries[i];
+        size_t j = i;
+        while(j > low && less(curr, entries[j - 1])){
+            entries[j] = entries[j - 1];
+            j--;
+        }
+        entries[j] = curr;
+    }
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef THREAD_POOL
+#define THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Work stealing thread pool, each worker owns a deque and steals from the others when idle
+class ThreadPool{
+    public:
+
+        /// @brief Starts the worker threads
+        /// @param threads Number of workers, 0 uses the hardware concurrency
+        explicit ThreadPool(unsigned int threads = 0);
+
+        /// @brief Finishes the queued tasks and joins every worker
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// @brief Pool with one worker per hardware thread, started on first use and kept until exit
+        /// @return Returns the shared pool
+        static ThreadPool& shared();
+
+        /// @brief Gets the number of workers
+        /// @return Returns the number of workers
+        unsigned int size();
+
+        /// @brief Queues a task, tasks submitted from a worker go to that worker's own deque
+        /// @param task Task to run
+        void submit(std::function<void()> task);
+
+        /// @brief Runs one queued task on the calling thread if there is one
+        /// @return Returns true if a task was run
+        bool runPending();
+
+    private:
+        struct Worker{
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::vector<std::thread> threads;
+        std::atomic<unsigned int> queued{0};
+        std::atomic<unsigned int> next{0};
+        std::atomic<bool> stopping{false};
+        std::mutex sleepLock;
+        std::condition_variable wake;
+
+        /// @brief Index of the worker owning the calling thread or -1 if it is not one of ours
+        int currentWorker();
+
+        /// @brief Pops from the back of our own deque, otherwise steals from the front of another
+        /// @param self Index to start looking from
+        /// @param task Set to the task found
+        /// @return Returns true if a task was found
+        bool take(unsigned int self, std::function<void()>& task);
+
+        /// @brief Loop run by every worker thread
+        void workerLoop(unsigned int index);
+
+        static thread_local ThreadPool* currentPool;
+        static thread_local int currentIndex;
+
+        //a waiting group sleeps on the same condition as the workers, so it wakes for new work as well as its own end
+        friend class TaskGroup;
+};
+
+/// @brief Group of tasks that can be waited on, the waiting thread helps run queued tasks
+class TaskGroup{
+    public:
+        explicit TaskGroup(ThreadPool& _pool) : pool(_pool) {};
+
+        /// @brief Waits for every task still running, an exception nobody waited for is dropped
+        ~TaskGroup() { drain(); };
+
+        /// @brief Submits a task to the pool as part of this group
+        /// @param task Task to run
+        void run(std::function<void()> task);
+
+        /// @brief Blocks until every task of the group finished
+        /// @throws Rethrows the first exception thrown by a task of the group
+        void wait();
+
+    private:
+        ThreadPool& pool;
+        std::atomic<unsigned int> pending{0};
+        std::mutex errorLock;
+        std::exception_ptr error;
+
+        /// @brief Runs queued tasks until the group is done, sleeping while there is nothing to run
+        void drain();
+};
+
+inline thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+inline thread_local int ThreadPool::currentIndex = -1;
+
+inline ThreadPool::ThreadPool(unsigned int count){
+    if(count == 0)
+        count = std::thread::hardware_concurrency();
+    if(count == 0)
+        count = 1;
+
+    for(unsigned int i = 0; i < count; i++){
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for(unsigned int i = 0; i < count; i++){
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+inline ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(std::thread& thread : threads){
+        thread.join();
+    }
+}
+
+inline ThreadPool& ThreadPool::shared(){
+    static ThreadPool pool;
+    return pool;
+}
+
+inline unsigned int ThreadPool::size(){
+    return workers.size();
+}
+
+inline int ThreadPool::currentWorker(){
+    return currentPool == this ? currentIndex : -1;
+}
+
+inline void ThreadPool::submit(std::function<void()> task){
+    int self = currentWorker();
+    unsigned int index = self >= 0 ? self : next++ % workers.size();
+    {
+        std::lock_guard<std::mutex> guard(workers[index]->lock);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    {
+        //taking the lock so a worker about to sleep can not miss the notify
+        std::lock_guard<std::mutex> guard(sleepLock);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+inline bool ThreadPool::take(unsigned int self, std::function<void()>& task){
+    if(queued == 0)
+        return false;
+
+    //own deque is used as a stack so recently split work stays in cache
+    {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if(!own.tasks.empty()){
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+
+    //steal the oldest task of someone else, which is usually the biggest piece of work, a busy deque is skipped
+    //on the first pass and waited for on the second, so false means every deque was seen empty
+    for(bool wait : {false, true}){
+        for(unsigned int i = 1; i < workers.size() && queued > 0; i++){
+            Worker& victim = *workers[(self + i) % workers.size()];
+            std::unique_lock<std::mutex> guard(victim.lock, std::defer_lock);
+            if(wait)
+                guard.lock();
+            else if(!guard.try_lock())
+                continue;
+            if(!victim.tasks.empty()){
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued--;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+inline bool ThreadPool::runPending(){
+    int self = currentWorker();
+    std::function<void()> task;
+    if(!take(self >= 0 ? self : next % workers.size(), task))
+        return false;
+    task();
+    return true;
+}
+
+inline void ThreadPool::workerLoop(unsigned int index){
+    currentPool = this;
+    currentIndex = index;
+    std::function<void()> task;
+    while(true){
+        if(take(index, task)){
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(sleepLock);
+        if(stopping && queued == 0)
+            return;
+        //queued only counts tasks already in a deque and take waits for busy ones, so it is never true here for long
+        wake.wait(guard, [this]{ return stopping || queued > 0; });
+    }
+}
+
+inline void TaskGroup::run(std::function<void()> task){
+    pending++;
+    pool.submit([this, task = std::move(task)]{
+        try{
+            task();
+        }
+        catch(...){
+            std::lock_guard<std::mutex> guard(errorLock);
+            if(!error)
+                error = std::current_exception();
+        }
+        //the group may be gone as soon as pending is 0, only the pool is touched after that
+        ThreadPool& owner = pool;
+        if(--pending > 0)
+            return;
+        {
+            //taking the lock so a waiter between its check and its sleep can not miss the notify
+            std::lock_guard<std::mutex> guard(owner.sleepLock);
+        }
+        owner.wake.notify_all();
+    });
+}
+
+inline void TaskGroup::drain(){
+    while(pending > 0){
+        if(pool.runPending())
+            continue;
+        std::unique_lock<std::mutex> guard(pool.sleepLock);
+        pool.wake.wait(guard, [this]{ return pending == 0 || pool.queued > 0; });
+    }
+}
+
+inline void TaskGroup::wait(){
+    drain();
+    if(error){
+        std::exception_ptr first = std::move(error);
+        error = nullptr;
+        std::rethrow_exception(first);
+    }
+}
+
+#endif
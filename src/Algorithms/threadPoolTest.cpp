@@ -0,0 +1,42 @@
+#include "threadPool.hpp"
+#include "../check.hpp"
+#include <atomic>
+#include <stdexcept>
+
+int main(){
+    //a throwing task still counts as finished, wait returns and hands back the first exception once
+    ThreadPool pool(2);
+    std::atomic<int> ran{0};
+    TaskGroup group(pool);
+    for(int i = 0; i < 100; i++){
+        group.run([&, i]{
+            ran++;
+            if(i % 10 == 0)
+                throw std::runtime_error("task failed");
+        });
+    }
+    check::throws<std::runtime_error>([&]{ group.wait(); }, "wait rethrows a task's exception");
+    check::that(ran == 100, "every task runs even after one threw");
+    group.wait();
+
+    //groups waited on from inside a task sleep or help instead of spinning, and still finish
+    std::atomic<int> leaves{0};
+    TaskGroup outer(pool);
+    for(int i = 0; i < 8; i++){
+        outer.run([&]{
+            TaskGroup inner(pool);
+            for(int j = 0; j < 8; j++)
+                inner.run([&]{ leaves++; });
+            inner.wait();
+        });
+    }
+    outer.wait();
+    check::that(leaves == 64, "nested groups finish");
+
+    //a group that is never waited on explicitly drops its exception instead of throwing from the destructor
+    {
+        TaskGroup dropped(pool);
+        dropped.run([]{ throw std::runtime_error("nobody waits"); });
+    }
+    return check::failures();
+}
@@ -0,0 +1,201 @@
+#ifndef ARRAY_STACK
+#define ARRAY_STACK
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace mystl{
+    /// @brief First in Last out container on one contiguous buffer, push is amortized O(1), pop and top are O(1)
+    /// The buffer doubles when full, and the first Inline elements live inside the stack itself so short stacks
+    /// never allocate
+    /// @tparam Inline Number of elements kept in place before the first allocation, 0 always uses the heap
+    template <typename T, unsigned int Inline = 0>
+    class ArrayStack{
+        public:
+
+            /// @brief Default Constructor
+            ArrayStack(){};
+
+            /// @brief Destroys every element and frees the buffer
+            ~ArrayStack();
+
+            /// @brief Copies the elements of other
+            ArrayStack(const ArrayStack& other);
+
+            /// @brief Takes the buffer of other, or moves its elements if they are inline
+            ArrayStack(ArrayStack&& other) noexcept;
+
+            /// @brief Replaces the elements with copies of other's
+            ArrayStack& operator=(const ArrayStack& other);
+
+            /// @brief Replaces the elements with other's
+            ArrayStack& operator=(ArrayStack&& other) noexcept;
+
+            /// @brief Gets the size of the Stack
+            /// @return Returns the size
+            unsigned int size();
+
+            /// @brief Gets how many elements fit before the buffer grows
+            unsigned int capacity();
+
+            /// @brief Makes room for at least count elements so pushing up to that many does not reallocate
+            void reserve(unsigned int count);
+
+            /// @brief Removes the top element
+            void pop();
+
+            /// @brief Insert element on top
+            void push(T value);
+
+            /// @brief Access the top of the stack
+            /// @return References to top
+            T& top();
+
+            /// @brief Checks whether Stack is empty
+            /// @return Returns true if size = 0
+            bool empty();
+
+            /// @brief Destroys every element, the buffer is kept for reuse
+            void clear();
+
+        private:
+            alignas(T) unsigned char small[Inline ? Inline * sizeof(T) : 1];
+            T* data = Inline ? reinterpret_cast<T*>(small) : nullptr;
+            unsigned int _size = 0;
+            unsigned int _capacity = Inline;
+
+            /// @brief Checks if the elements are in the inline buffer
+            bool isInline() { return static_cast<void*>(data) == static_cast<void*>(small); };
+
+            /// @brief Moves the elements to a heap buffer of newCapacity elements
+            void grow(unsigned int newCapacity);
+
+            /// @brief Frees the heap buffer, if there is one, and goes back to the inline one
+            void freeBuffer();
+    };
+}
+
+template <typename T, unsigned int Inline>
+mystl::ArrayStack<T, Inline>::~ArrayStack(){
+    clear();
+    freeBuffer();
+}
+
+template <typename T, unsigned int Inline>
+mystl::ArrayStack<T, Inline>::ArrayStack(const ArrayStack& other){
+    reserve(other._size);
+    std::uninitialized_copy(other.data, other.data + other._size, data);
+    _size = other._size;
+}
+
+template <typename T, unsigned int Inline>
+mystl::ArrayStack<T, Inline>::ArrayStack(ArrayStack&& other) noexcept{
+    *this = std::move(other);
+}
+
+template <typename T, unsigned int Inline>
+mystl::ArrayStack<T, Inline>& mystl::ArrayStack<T, Inline>::operator=(const ArrayStack& other){
+    if(this == &other)
+        return *this;
+    clear();
+    reserve(other._size);
+    std::uninitialized_copy(other.data, other.data + other._size, data);
+    _size = other._size;
+    return *this;
+}
+
+template <typename T, unsigned int Inline>
+mystl::ArrayStack<T, Inline>& mystl::ArrayStack<T, Inline>::operator=(ArrayStack&& other) noexcept{
+    if(this == &other)
+        return *this;
+    clear();
+    if(other.isInline()){
+        //inline elements can not change owner, they are moved one by one into whatever buffer we have
+        std::uninitialized_move(other.data, other.data + other._size, data);
+        _size = other._size;
+        other.clear();
+        return *this;
+    }
+    freeBuffer();
+    data = other.data;
+    _size = other._size;
+    _capacity = other._capacity;
+    other.data = Inline ? reinterpret_cast<T*>(other.small) : nullptr;
+    other._size = 0;
+    other._capacity = Inline;
+    return *this;
+}
+
+template <typename T, unsigned int Inline>
+unsigned int mystl::ArrayStack<T, Inline>::size(){
+    return _size;
+}
+
+template <typename T, unsigned int Inline>
+unsigned int mystl::ArrayStack<T, Inline>::capacity(){
+    return _capacity;
+}
+
+template <typename T, unsigned int Inline>
+void mystl::ArrayStack<T, Inline>::reserve(unsigned int count){
+    if(count > _capacity)
+        grow(count);
+}
+
+template <typename T, unsigned int Inline>
+void mystl::ArrayStack<T, Inline>::pop(){
+    if(_size == 0)
+        throw std::out_of_range("Stack is empty");
+    std::destroy_at(data + --_size);
+}
+
+template <typename T, unsigned int Inline>
+void mystl::ArrayStack<T, Inline>::push(T value){
+    if(_size == _capacity)
+        grow(std::max(2 * _capacity, 4u));
+    ::new(static_cast<void*>(data + _size)) T(std::move(value));
+    _size++;
+}
+
+template <typename T, unsigned int Inline>
+T& mystl::ArrayStack<T, Inline>::top(){
+    if(_size == 0)
+        throw std::out_of_range("Stack is empty");
+    return data[_size - 1];
+}
+
+template <typename T, unsigned int Inline>
+bool mystl::ArrayStack<T, Inline>::empty(){
+    return _size == 0;
+}
+
+template <typename T, unsigned int Inline>
+void mystl::ArrayStack<T, Inline>::clear(){
+    std::destroy(data, data + _size);
+    _size = 0;
+}
+
+template <typename T, unsigned int Inline>
+void mystl::ArrayStack<T, Inline>::grow(unsigned int newCapacity){
+    T* buffer = static_cast<T*>(::operator new(newCapacity * sizeof(T), std::align_val_t(alignof(T))));
+    std::uninitialized_move(data, data + _size, buffer);
+    std::destroy(data, data + _size);
+    unsigned int size = _size;
+    freeBuffer();
+    data = buffer;
+    _size = size;
+    _capacity = newCapacity;
+}
+
+template <typename T, unsigned int Inline>
+void mystl::ArrayStack<T, Inline>::freeBuffer(){
+    if(data && !isInline())
+        ::operator delete(data, std::align_val_t(alignof(T)));
+    data = Inline ? reinterpret_cast<T*>(small) : nullptr;
+    _capacity = Inline;
+}
+
+#endif
@@ -0,0 +1,282 @@
+#include "main.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Fenwick tree counting which keys in [0, n) are present, to rank a popped key against the rest
+class PresentKeys{
+    public:
+        explicit PresentKeys(size_t n) : tree(n + 1, 0) {};
+
+        void add(size_t key, int delta){
+            for(size_t i = key + 1; i < tree.size(); i += i & -i)
+                tree[i] += delta;
+        }
+
+        /// @brief Counts the present keys smaller than key
+        size_t below(size_t key){
+            size_t count = 0;
+            for(size_t i = key; i > 0; i -= i & -i)
+                count += tree[i];
+            return count;
+        }
+
+    private:
+        std::vector<size_t> tree;
+};
+
+/// @brief Concurrent priority queue run by the throughput benchmark
+struct Queue{
+    std::string name;
+    std::function<void(unsigned int value)> push;
+    std::function<bool(unsigned int& value)> pop;
+};
+
+/// @brief Timing and rank error of one queue at one thread count
+struct Result{
+    double ms;
+    double meanRankError;
+    size_t maxRankError;
+};
+
+/// @brief Prefills the queue, then every thread alternates push and pop until ops operations are done in total
+static double throughput(Queue& queue, unsigned int threads, size_t ops, size_t prefill){
+    std::mt19937 rng(12345);
+    for(size_t i = 0; i < prefill; i++)
+        queue.push(rng());
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for(unsigned int t = 0; t < threads; t++){
+        workers.emplace_back([&, t]{
+            std::minstd_rand local(t + 1);
+            while(!go.load(std::memory_order_acquire));
+            unsigned int value;
+            for(size_t i = 0; i < ops / threads; i += 2){
+                queue.push(local());
+                queue.pop(value);
+            }
+        });
+    }
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for(std::thread& worker : workers)
+        worker.join();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Rank error of the MultiQueue sized for threads, popped and refilled in steady state by one thread
+/// The rank of a pop is how many larger keys were still queued, a strict heap always has 0
+/// Running it on one thread keeps the count exact, the error comes from the number of shards, not the interleaving
+static void rankError(unsigned int threads, size_t prefill, Result& result){
+    size_t keys = 2 * prefill;
+    std::vector<unsigned int> order(keys);
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 rng(12345);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    mystl::MultiQueue<unsigned int> queue(threads);
+    PresentKeys present(keys);
+    for(size_t i = 0; i < prefill; i++){
+        queue.push(order[i]);
+        present.add(order[i], 1);
+    }
+
+    double total = 0;
+    result.maxRankError = 0;
+    for(size_t i = prefill; i < keys; i++){
+        unsigned int value;
+        queue.tryPop(value);
+        present.add(value, -1);
+        size_t rank = queue.size() - present.below(value);
+        total += rank;
+        result.maxRankError = std::max(result.maxRankError, rank);
+        queue.push(order[i]);
+        present.add(order[i], 1);
+    }
+    result.meanRankError = total / prefill;
+}
+
+/// @brief Times fn once and returns the milliseconds taken
+static double timeMs(const std::function<void()>& fn){
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Serial single heap workloads on the array Heap and the PairingHeap, N random inserts then N pops, and
+/// melding two heaps of N/2, which the array heap can only do by popping one into the other
+static int heaps(size_t maxSize, const std::string& csvPath){
+    std::ofstream csv(csvPath);
+    csv << "heap,workload,size,ms\n";
+    std::cout << "heap          workload  size        ms\n";
+    auto report = [&](const char* heap, const char* workload, size_t size, double ms){
+        csv << heap << "," << workload << "," << size << "," << ms << "\n";
+        std::printf("%-13s %-9s %-11zu %.2f\n", heap, workload, size, ms);
+    };
+
+    std::mt19937 rng(12345);
+    for(size_t size = 10000; size <= maxSize; size *= 10){
+        std::vector<unsigned int> input(size);
+        for(unsigned int& value : input)
+            value = rng();
+
+        unsigned int check = 0;
+        report("heap", "pushPop", size, timeMs([&]{
+            mystl::Heap<unsigned int> heap;
+            for(unsigned int value : input)
+                heap.insert(value);
+            while(!heap.empty()){
+                check += heap.getMax();
+                heap.removeMax();
+            }
+        }));
+        report("pairingHeap", "pushPop", size, timeMs([&]{
+            mystl::PairingHeap<unsigned int> heap;
+            for(unsigned int value : input)
+                heap.insert(value);
+            while(!heap.empty()){
+                check -= heap.getMax();
+                heap.removeMax();
+            }
+        }));
+        if(check != 0){
+            std::cerr << "heaps popped different values\n";
+            return 1;
+        }
+
+        //taking out half the heap one at a time against one batch, only the pops are timed
+        mystl::Heap<unsigned int> popped(input);
+        mystl::Heap<unsigned int> batched(input);
+        std::vector<unsigned int> one;
+        std::vector<unsigned int> batch;
+        report("heap", "popHalf", size, timeMs([&]{
+            for(size_t i = 0; i < size / 2; i++){
+                one.push_back(popped.getMax());
+                popped.removeMax();
+            }
+        }));
+        report("heap", "batchHalf", size, timeMs([&]{ batched.popBatch(size / 2, batch); }));
+        if(one != batch || popped.getMax() != batched.getMax()){
+            std::cerr << "popBatch differs from removeMax\n";
+            return 1;
+        }
+
+        //a quarter of the heap again, but in batches of 1000 that are sifted instead of rebuilt
+        one.clear();
+        batch.clear();
+        report("heap", "pop1k", size, timeMs([&]{
+            for(size_t i = 0; i < size / 4000 * 1000; i++){
+                one.push_back(popped.getMax());
+                popped.removeMax();
+            }
+        }));
+        report("heap", "batch1k", size, timeMs([&]{
+            for(size_t i = 0; i < size / 4000; i++)
+                batched.popBatch(1000, batch);
+        }));
+        if(one != batch || popped.getMax() != batched.getMax()){
+            std::cerr << "popBatch differs from removeMax\n";
+            return 1;
+        }
+
+        //only the meld itself is timed
+        mystl::Heap<unsigned int> left;
+        mystl::Heap<unsigned int> right;
+        mystl::PairingHeap<unsigned int> pairedLeft;
+        mystl::PairingHeap<unsigned int> pairedRight;
+        for(size_t i = 0; i < size; i++){
+            (i % 2 ? left : right).insert(input[i]);
+            (i % 2 ? pairedLeft : pairedRight).insert(input[i]);
+        }
+        report("heap", "meld", size, timeMs([&]{
+            while(!right.empty()){
+                left.insert(right.getMax());
+                right.removeMax();
+            }
+        }));
+        report("pairingHeap", "meld", size, timeMs([&]{ pairedLeft.meld(pairedRight); }));
+        if(left.size() != pairedLeft.size() || left.getMax() != pairedLeft.getMax()){
+            std::cerr << "melded heaps differ\n";
+            return 1;
+        }
+    }
+    std::cout << "\nwrote " << csvPath << "\n";
+    return 0;
+}
+
+int main(int argc, char** argv){
+    unsigned int maxThreads = 64;
+    size_t ops = 4000000;
+    size_t prefill = 1 << 16;
+    std::string csvPath = "benchmark.csv";
+    size_t heapSize = 0;
+    for(int i = 1; i + 1 < argc; i += 2){
+        std::string arg = argv[i];
+        if(arg == "--threads")
+            maxThreads = std::stoul(argv[i+1]);
+        else if(arg == "--ops")
+            ops = std::stod(argv[i+1]);
+        else if(arg == "--prefill")
+            prefill = std::stod(argv[i+1]);
+        else if(arg == "--csv")
+            csvPath = argv[i+1];
+        else if(arg == "--heaps")
+            heapSize = std::stod(argv[i+1]);
+        else{
+            std::cerr << "usage: " << argv[0] << " [--threads maxThreads] [--ops N] [--prefill N] [--csv path] [--heaps maxSize]\n";
+            return 1;
+        }
+    }
+    if(heapSize > 0)
+        return heaps(heapSize, csvPath);
+
+    std::ofstream csv(csvPath);
+    csv << "queue,threads,ops,ms,mops_per_second,mean_rank_error,max_rank_error\n";
+    std::printf("%u operations, %zu prefilled, hardware threads: %u\n\n", (unsigned int)ops, prefill, std::thread::hardware_concurrency());
+    std::cout << "queue         threads  ms          Mops/s    mean rank error  max rank error\n";
+
+    for(unsigned int threads = 1; threads <= maxThreads; threads *= 2){
+        //the design being replaced, one heap behind one mutex
+        mystl::Heap<unsigned int> heap;
+        std::mutex heapLock;
+        mystl::MultiQueue<unsigned int> multiQueue(threads);
+        std::vector<Queue> queues = {
+            {"lockedHeap",
+             [&](unsigned int value){ std::lock_guard<std::mutex> guard(heapLock); heap.insert(value); },
+             [&](unsigned int& value){
+                 std::lock_guard<std::mutex> guard(heapLock);
+                 if(heap.empty())
+                     return false;
+                 value = heap.getMax();
+                 heap.removeMax();
+                 return true;
+             }},
+            {"multiQueue",
+             [&](unsigned int value){ multiQueue.push(value); },
+             [&](unsigned int& value){ return multiQueue.tryPop(value); }},
+        };
+
+        for(Queue& queue : queues){
+            Result result = {throughput(queue, threads, ops, prefill), 0, 0};
+            if(queue.name == "multiQueue")
+                rankError(threads, prefill, result);
+            double mops = ops / result.ms / 1000;
+            csv << queue.name << "," << threads << "," << ops << "," << result.ms << "," << mops << ","
+                << result.meanRankError << "," << result.maxRankError << "\n";
+            std::printf("%-13s %-8u %-11.1f %-9.2f %-16.2f %zu\n", queue.name.c_str(), threads, result.ms, mops,
+                        result.meanRankError, result.maxRankError);
+        }
+    }
+    std::cout << "\nwrote " << csvPath << "\n";
+    return 0;
+}
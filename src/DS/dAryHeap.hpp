@@ -0,0 +1,133 @@
+#ifndef D_ARY_HEAP
+#define D_ARY_HEAP
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mystl{
+    /// @brief Heap where every node has D children, the top is the largest element by Compare
+    /// A 4-ary heap is half as deep as a binary one and the children of a node sit next to each other, so with small
+    /// elements a sift down reads one or two cache lines per level instead of one per child
+    /// @tparam D Number of children per node, 2, 4 or 8 make the index math shifts
+    /// @tparam Compare Less than comparison, std::greater<T> makes it a min heap
+    template <typename T, unsigned int D = 4, typename Compare = std::less<T>>
+    class DAryHeap{
+        public:
+            static_assert(D >= 2, "A heap needs at least two children per node");
+
+            /// @brief Makes an empty heap
+            /// @param _compare Comparison object to order the elements with
+            explicit DAryHeap(const Compare& _compare = Compare()) : compare(_compare) {};
+
+            /// @brief Gets size of heap
+            /// @return Returns size
+            unsigned int size();
+
+            /// @brief Checks if the heap is empty
+            /// @return Return true if heap is empty
+            bool empty();
+
+            /// @brief Insert new value in heap
+            void insert(T data);
+
+            /// @brief Gets the largest value by Compare
+            /// @return Reference to the top value
+            const T& top();
+
+            /// @brief Removes the top value and updates the heap
+            void pop();
+
+            /// @brief Clears the heap and resets to size 0
+            void clear();
+
+        private:
+            std::vector<T> heap;
+            Compare compare;
+
+            /// @brief Moves the hole at index up until value fits, then puts value in it
+            void siftUp(unsigned int index, T value);
+
+            /// @brief Moves the hole at index down until value fits, then puts value in it
+            void siftDown(unsigned int index, T value);
+    };
+}
+
+template <typename T, unsigned int D, typename Compare>
+unsigned int mystl::DAryHeap<T, D, Compare>::size(){
+    return heap.size();
+}
+
+template <typename T, unsigned int D, typename Compare>
+bool mystl::DAryHeap<T, D, Compare>::empty(){
+    return heap.size() == 0;
+}
+
+template <typename T, unsigned int D, typename Compare>
+void mystl::DAryHeap<T, D, Compare>::insert(T data){
+    //the value goes in as the new last slot and is moved back out for the sift, so T needs no default constructor
+    heap.push_back(std::move(data));
+    siftUp(heap.size() - 1, std::move(heap.back()));
+}
+
+template <typename T, unsigned int D, typename Compare>
+const T& mystl::DAryHeap<T, D, Compare>::top(){
+    if(heap.size() == 0)
+        throw std::out_of_range("Heap is empty");
+    return heap[0];
+}
+
+template <typename T, unsigned int D, typename Compare>
+void mystl::DAryHeap<T, D, Compare>::pop(){
+    if(heap.size() == 0)
+        throw std::out_of_range("Heap is empty");
+    T last = std::move(heap.back());
+    heap.pop_back();
+    if(heap.size() > 0)
+        siftDown(0, std::move(last));
+}
+
+template <typename T, unsigned int D, typename Compare>
+void mystl::DAryHeap<T, D, Compare>::clear(){
+    heap.clear();
+}
+
+template <typename T, unsigned int D, typename Compare>
+void mystl::DAryHeap<T, D, Compare>::siftUp(unsigned int index, T value){
+    //parents move down into the hole, value is written once where it stops
+    while(index > 0){
+        unsigned int parent = (index - 1) / D;
+        if(!compare(heap[parent], value))
+            break;
+        heap[index] = std::move(heap[parent]);
+        index = parent;
+    }
+    heap[index] = std::move(value);
+}
+
+template <typename T, unsigned int D, typename Compare>
+void mystl::DAryHeap<T, D, Compare>::siftDown(unsigned int index, T value){
+    unsigned int size = heap.size();
+    while(true){
+        unsigned int first = index * D + 1;
+        if(first >= size)
+            break;
+
+        //largest of the up to D children, which sit next to each other in memory
+        unsigned int last = first + D < size ? first + D : size;
+        unsigned int best = first;
+        for(unsigned int child = first + 1; child < last; child++){
+            if(compare(heap[best], heap[child]))
+                best = child;
+        }
+
+        if(!compare(value, heap[best]))
+            break;
+        heap[index] = std::move(heap[best]);
+        index = best;
+    }
+    heap[index] = std::move(value);
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include "dAryHeap.hpp"
+#include "../check.hpp"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+/// @brief Value without a default constructor, the heap may only copy and move it
+struct Distance{
+    explicit Distance(int _value) : value(_value) {};
+    int value;
+    bool operator<(const Distance& other) const { return value < other.value; }
+};
+
+int main(){
+    //elements are inserted without default constructing a slot and come out largest first
+    mystl::DAryHeap<Distance> heap;
+    std::mt19937 rng(1);
+    std::vector<int> values(1000);
+    for(int& value : values){
+        value = rng() % 100;
+        heap.insert(Distance(value));
+    }
+    std::sort(values.begin(), values.end(), std::greater<int>());
+    std::vector<int> popped;
+    while(!heap.empty()){
+        popped.push_back(heap.top().value);
+        heap.pop();
+    }
+    check::that(popped == values, "DAryHeap did not pop in descending order");
+
+    //std::greater makes it a min heap
+    mystl::DAryHeap<int, 8, std::greater<int>> minHeap;
+    for(int value : {5, 2, 9, 2, 7})
+        minHeap.insert(value);
+    check::that(minHeap.top() == 2, "min heap top is not the smallest");
+    return check::failures();
+}
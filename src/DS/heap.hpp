@@ -2,7 +2,13 @@
 #define HEAP
 
 #include <vector>
+#include <algorithm>
+#include <bit>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 
 namespace mystl{
     /// @brief Max heap implementation with fixed time to access max value
@@ -10,6 +16,13 @@ namespace mystl{
     class Heap{
         public:
 
+            /// @brief Makes an empty heap
+            Heap(){};
+
+            /// @brief Builds a heap of the given values in O(N) with Floyd's method
+            /// @param data Values to take, moved into the heap
+            explicit Heap(std::vector<T> data);
+
             /// @brief Gets size of heap
             /// @return Returns size
             unsigned int size();
@@ -17,6 +30,9 @@ namespace mystl{
             /// @brief Insert new value in heap        
             void insert(T data);
 
+            /// @brief Inserts every value, rebuilding with Floyd's method in O(N) when that beats sifting each one up
+            void insertRange(const std::vector<T>& data);
+
             /// @brief Get the max value in the heap
             /// @return Reference to max value
             T& getMax();
@@ -24,6 +40,14 @@ namespace mystl{
             /// @brief Remove the max value update heap
             void removeMax();
 
+            /// @brief Removes the k largest values and appends them to out in descending order
+            /// They are found through a small heap over the frontier of the top subtree in O(K Log(K)), then the holes
+            /// they leave are filled from the back and sifted a level at a time from the deepest up, each starting
+            /// below the root, once k sifts cost more than a rebuild they are selected and the rest is rebuilt instead
+            /// @param k Number of values to remove, all of them if the heap is smaller
+            /// @param out Buffer the values are appended to
+            void popBatch(unsigned int k, std::vector<T>& out);
+
             /// @brief Checks if the heap is empty
             /// @return Return true if heap is empty
             bool empty();
@@ -38,12 +62,38 @@ namespace mystl{
             /// @param index 
             void heapifyDown(unsigned int index);
 
+            /// @brief Moves the k largest values to out in descending order without touching the rest of the heap
+            /// @return Returns the slots they were taken from, closed under parent
+            std::vector<unsigned int> takeLargest(unsigned int k, std::vector<T>& out);
+
+            /// @brief Sifts the top of a heap of heap indices down, ordered by the values they point at
+            template <typename Smaller>
+            static void sinkCandidate(std::vector<unsigned int>& frontier, Smaller smaller);
+
+            /// @brief Refills holes that are closed under parent, a level at a time from the deepest up
+            void siftHoles(const std::vector<unsigned int>& holes);
+
+            /// @brief Moves the hole at index down to a leaf along the larger children, then lets value climb back
+            /// no higher than top, Floyd's leaf search for values that belong near the bottom
+            void settle(unsigned int index, unsigned int top, T value);
+
             /// @brief Update the heap when new element inserted
             /// @param index 
             void heapifyUp(unsigned int index);
+
+            /// @brief Floyd's heap construction, sifts down every parent from the last one up
+            void buildHeap();
+
+            /// @brief Checks if count sifts over the current size cost more than rebuilding it
+            bool cheaperToRebuild(size_t count);
     };
 }
 
+template <typename T>
+mystl::Heap<T>::Heap(std::vector<T> data) : heap(std::move(data)){
+    buildHeap();
+}
+
 template <typename T>
 void mystl::Heap<T>::clear(){
     heap.clear();
@@ -63,7 +113,7 @@ template <typename T>
 void mystl::Heap<T>::removeMax(){
     if(heap.size() == 0)
         throw std::out_of_range("Heap is empty");
-    heap[0] = heap.back();
+    heap[0] = std::move(heap.back());
     heap.pop_back();
     heapifyDown(0);
 }
@@ -79,32 +129,239 @@ void mystl::Heap<T>::insert(T data){
     heapifyUp(heap.size() -1);
 }
 
+template <typename T>
+void mystl::Heap<T>::insertRange(const std::vector<T>& data){
+    size_t oldSize = heap.size();
+    heap.insert(heap.end(), data.begin(), data.end());
+    if(cheaperToRebuild(data.size())){
+        buildHeap();
+        return;
+    }
+    for(size_t i = oldSize; i < heap.size(); i++){
+        heapifyUp(i);
+    }
+}
+
+template <typename T>
+void mystl::Heap<T>::popBatch(unsigned int k, std::vector<T>& out){
+    k = std::min<size_t>(k, heap.size());
+    if(k == 0)
+        return;
+    out.reserve(out.size() + k);
+
+    if(cheaperToRebuild(k)){
+        //the heap is rebuilt anyway, and a frontier this big no longer fits in cache, so the k largest are
+        //split off with a selection and only they are sorted
+        auto larger = [](const T& a, const T& b){ return b < a; };
+        auto split = heap.end() - k;
+        std::nth_element(heap.begin(), split, heap.end());
+        std::sort(split, heap.end(), larger);
+        out.insert(out.end(), std::make_move_iterator(split), std::make_move_iterator(heap.end()));
+        heap.erase(split, heap.end());
+        buildHeap();
+        return;
+    }
+
+    std::vector<unsigned int> holes = takeLargest(k, out);
+    //holes before the new end are filled with the values of the last k slots that were not taken,
+    //only the few taken slots among those need to be known in order
+    unsigned int remaining = heap.size() - k;
+    std::vector<unsigned int> takenTail;
+    std::erase_if(holes, [&](unsigned int index){
+        if(index < remaining)
+            return false;
+        takenTail.push_back(index);
+        return true;
+    });
+    std::sort(takenTail.begin(), takenTail.end());
+    auto skip = takenTail.begin();
+    unsigned int tail = remaining;
+    for(unsigned int index : holes){
+        for(; skip != takenTail.end() && *skip == tail; skip++)
+            tail++;
+        heap[index] = std::move(heap[tail++]);
+    }
+    heap.resize(remaining);
+    siftHoles(holes);
+}
+
+template <typename T>
+std::vector<unsigned int> mystl::Heap<T>::takeLargest(unsigned int k, std::vector<T>& out){
+    //the k largest are a subtree hanging from the root, taken best first from a small heap over its frontier
+    auto smaller = [this](unsigned int a, unsigned int b){ return heap[a] < heap[b]; };
+    std::vector<unsigned int> frontier{0};
+    std::vector<unsigned int> taken;
+    frontier.reserve(k + 1);
+    taken.reserve(k);
+    while(taken.size() < k){
+        unsigned int index = frontier[0];
+        taken.push_back(index);
+        //the left child replaces the taken index at the top of the frontier, the right child is pushed and rarely
+        //rises far, so every value taken costs one sift of the small heap
+        unsigned int left = index*2+1;
+        if(left < heap.size()){
+            frontier[0] = left;
+        }
+        else{
+            frontier[0] = frontier.back();
+            frontier.pop_back();
+        }
+        if(!frontier.empty())
+            sinkCandidate(frontier, smaller);
+        if(left+1 < heap.size()){
+            frontier.push_back(left+1);
+            std::push_heap(frontier.begin(), frontier.end(), smaller);
+        }
+        //nothing compares against a taken value again, only against its children
+        out.push_back(std::move(heap[index]));
+    }
+    return taken;
+}
+
+template <typename T>
+template <typename Smaller>
+void mystl::Heap<T>::sinkCandidate(std::vector<unsigned int>& frontier, Smaller smaller){
+    //a child of the last value taken usually belongs near the bottom, so it follows the larger children all the way
+    //down and climbs back, one comparison per level picked without a branch since the frontier is in cache
+    unsigned int candidate = frontier[0];
+    size_t index = 0;
+    while(index*2+2 < frontier.size()){
+        size_t largest = index*2+1;
+        largest += smaller(frontier[largest], frontier[largest+1]);
+        frontier[index] = frontier[largest];
+        index = largest;
+    }
+    if(index*2+1 < frontier.size()){
+        frontier[index] = frontier[index*2+1];
+        index = index*2+1;
+    }
+    while(index > 0 && smaller(frontier[(index - 1) / 2], candidate)){
+        frontier[index] = frontier[(index - 1) / 2];
+        index = (index - 1) / 2;
+    }
+    frontier[index] = candidate;
+}
+
+template <typename T>
+void mystl::Heap<T>::buildHeap(){
+    for(size_t i = heap.size() / 2; i > 0; i--){
+        heapifyDown(i - 1);
+    }
+}
+
+template <typename T>
+bool mystl::Heap<T>::cheaperToRebuild(size_t count){
+    //each sift is up to Log(N) levels, the rebuild does about 2N comparisons
+    return count * std::bit_width(heap.size()) > 2 * heap.size();
+}
+
 template <typename T>
 void mystl::Heap<T>::heapifyDown(unsigned int index){
-    unsigned int leftChild = index*2+1;
-    unsigned int rightChild = index*2+2;
-    unsigned int largest = index;
+    if(index >= heap.size())
+        return;
+
+    //children move up into the hole, the value is written once where it stops
+    T value = std::move(heap[index]);
+    while(true){
+        unsigned int leftChild = index*2+1;
+        unsigned int rightChild = index*2+2;
+        if(leftChild >= heap.size())
+            break;
+
+        unsigned int largest = leftChild;
+        if(rightChild < heap.size() && heap[leftChild] < heap[rightChild]){
+            largest = rightChild;
+        }
+        if(!(value < heap[largest]))
+            break;
 
-    if(leftChild < heap.size() && heap[leftChild] > heap[index]){
-        largest = leftChild;
+        heap[index] = std::move(heap[largest]);
+        index = largest;
     }
-    if(rightChild < heap.size() && heap[rightChild] > heap[largest]){
-        largest = rightChild;
+    heap[index] = std::move(value);
+}
+
+template <typename T>
+void mystl::Heap<T>::siftHoles(const std::vector<unsigned int>& holes){
+    //holes are bucketed by depth, a counting sort since there are at most 32 depths
+    constexpr unsigned int depths = std::numeric_limits<unsigned int>::digits + 1;
+    size_t levelStart[depths + 1] = {};
+    for(unsigned int index : holes)
+        levelStart[std::bit_width(index + 1) + 1]++;
+    for(unsigned int depth = 1; depth <= depths; depth++)
+        levelStart[depth] += levelStart[depth - 1];
+    std::vector<unsigned int> byDepth(holes.size());
+    for(unsigned int index : holes)
+        byDepth[levelStart[std::bit_width(index + 1)]++] = index;
+
+    //holes at one depth have disjoint subtrees, so their descents are stepped together a level at a time and the
+    //cache misses of one overlap with the others instead of each waiting for the one before
+    std::vector<T> values;
+    std::vector<unsigned int> cursors;
+    size_t end = byDepth.size();
+    for(unsigned int depth = depths; end > 0; depth--){
+        //placing moved every start up to the next depth's, so this depth starts where the one above ends
+        size_t begin = levelStart[depth - 1];
+        if(begin == end)
+            continue;
+        cursors.assign(byDepth.begin() + begin, byDepth.begin() + end);
+        values.clear();
+        for(unsigned int index : cursors)
+            values.push_back(std::move(heap[index]));
+
+        //the furthest right hole of the level gets through both children last, every other one has them until then
+        size_t right = std::max_element(cursors.begin(), cursors.end()) - cursors.begin();
+        while(cursors[right]*2+2 < heap.size()){
+            for(unsigned int& index : cursors){
+                unsigned int largest = index*2+1;
+                //nothing waits on this choice, so it is added in instead of branched on and mispredicted
+                largest += heap[largest] < heap[largest+1];
+                heap[index] = std::move(heap[largest]);
+                index = largest;
+            }
+        }
+        for(size_t i = 0; i < cursors.size(); i++)
+            settle(cursors[i], byDepth[begin + i], std::move(values[i]));
+        end = begin;
     }
+}
 
-    if(largest != index){
-        std::swap(heap[index], heap[largest]);
-        heapifyDown(largest);
+template <typename T>
+void mystl::Heap<T>::settle(unsigned int index, unsigned int top, T value){
+    //the larger child moves up at every level down to a leaf, then the value climbs back to its place,
+    //values from the tail are small so the climb is short and each level costs one comparison instead of two
+    while(index*2+2 < heap.size()){
+        unsigned int largest = index*2+1;
+        if(heap[largest] < heap[largest+1])
+            largest++;
+        heap[index] = std::move(heap[largest]);
+        index = largest;
+    }
+    if(index*2+1 < heap.size()){
+        heap[index] = std::move(heap[index*2+1]);
+        index = index*2+1;
+    }
+    while(index > top){
+        unsigned int parent = (index - 1) / 2;
+        if(!(heap[parent] < value))
+            break;
+        heap[index] = std::move(heap[parent]);
+        index = parent;
     }
+    heap[index] = std::move(value);
 }
 
 template <typename T>
 void mystl::Heap<T>::heapifyUp(unsigned int index){
-    unsigned int parent = index / 2;
-    if(heap[parent] < heap[index]){
-        std::swap(heap[parent], heap[index]);
-        heapifyUp(parent);
+    T value = std::move(heap[index]);
+    while(index > 0){
+        unsigned int parent = (index - 1) / 2;
+        if(!(heap[parent] < value))
+            break;
+        heap[index] = std::move(heap[parent]);
+        index = parent;
     }
+    heap[index] = std::move(value);
 }
 
 #endif
\ No newline at end of file
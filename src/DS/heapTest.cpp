@@ -0,0 +1,39 @@
+#include "heap.hpp"
+#include "../check.hpp"
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+int main(){
+    //popBatch has to hand out the same values as removeMax for every batch size, sifted or rebuilt, with duplicates
+    std::mt19937 rng(20);
+    for(unsigned int size : {0u, 1u, 2u, 7u, 100u, 5000u}){
+        for(unsigned int range : {3u, 1000000u}){
+            std::vector<int> input(size);
+            for(int& value : input)
+                value = rng() % range;
+            mystl::Heap<int> batched(input);
+            mystl::Heap<int> single(input);
+            for(unsigned int k : {1u, 3u, 50u, size / 2 + 1, size + 5}){
+                std::vector<int> batch;
+                std::vector<int> one;
+                batched.popBatch(k, batch);
+                for(unsigned int i = 0; i < k && !single.empty(); i++){
+                    one.push_back(single.getMax());
+                    single.removeMax();
+                }
+                check::that(batch == one, "popBatch differs from removeMax");
+                check::that(batched.size() == single.size(), "popBatch left the wrong size");
+                if(!single.empty())
+                    check::that(batched.getMax() == single.getMax(), "popBatch left a broken heap");
+                std::vector<int> more(size / 3);
+                for(int& value : more)
+                    value = rng() % range;
+                batched.insertRange(more);
+                single.insertRange(more);
+            }
+        }
+    }
+    return check::failures();
+}
@@ -0,0 +1,276 @@
+#ifndef INDEXED_HEAP
+#define INDEXED_HEAP
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mystl{
+    /// @brief D-ary heap where every element has a stable handle, so its key can be changed or it can be
+    /// erased in O(Log(N)) instead of pushing duplicates
+    /// @tparam D Number of children per node
+    /// @tparam Compare Less than comparison, std::greater<Key> makes it the min heap a shortest path search pops,
+    /// keys are raised and lowered in its order, so shortening a distance there is increaseKey
+    template <typename Key, unsigned int D = 4, typename Compare = std::less<Key>>
+    class IndexedHeap{
+        public:
+            static_assert(D >= 2, "A heap needs at least two children per node");
+
+            /// @brief Identifies an element for as long as it is in the heap
+            /// The low 32 bits are a slot that is reused once the element leaves, the high 32 bits count how often the
+            /// slot was used, so a handle kept after its element left is rejected instead of naming a newer element
+            using Handle = uint64_t;
+
+            /// @brief Makes an empty heap
+            /// @param _compare Comparison object to order the keys with
+            explicit IndexedHeap(const Compare& _compare = Compare()) : compare(_compare) {};
+
+            /// @brief Gets size of heap
+            /// @return Returns size
+            unsigned int size();
+
+            /// @brief Checks if the heap is empty
+            /// @return Return true if heap is empty
+            bool empty();
+
+            /// @brief Inserts a new key
+            /// @return Returns the handle of the new element
+            Handle insert(Key key);
+
+            /// @brief Gets the largest key by Compare
+            const Key& top();
+
+            /// @brief Gets the handle of the largest key by Compare
+            Handle topHandle();
+
+            /// @brief Removes the largest key, its handle becomes invalid
+            void pop();
+
+            /// @brief Checks if the handle belongs to an element in the heap
+            bool contains(Handle handle);
+
+            /// @brief Gets the key of an element
+            const Key& key(Handle handle);
+
+            /// @brief Raises the key of an element and moves it up
+            /// @param key New key, throws std::invalid_argument if it is smaller than the current one
+            void increaseKey(Handle handle, Key key);
+
+            /// @brief Lowers the key of an element and moves it down
+            /// @param key New key, throws std::invalid_argument if it is bigger than the current one
+            void decreaseKey(Handle handle, Key key);
+
+            /// @brief Removes an element, its handle becomes invalid
+            void erase(Handle handle);
+
+            /// @brief Clears the heap and resets to size 0, every handle becomes invalid
+            void clear();
+
+        private:
+            /// @brief Heap slot, the handle's slot travels with the key so moving an entry can update its position
+            struct Entry{
+                Key key;
+                unsigned int slot;
+            };
+
+            static constexpr unsigned int absent = std::numeric_limits<unsigned int>::max();
+
+            std::vector<Entry> heap;
+            //heap index of every slot, absent for slots not in the heap
+            std::vector<unsigned int> position;
+            //generation of every slot, bumped when its element leaves so older handles stop matching
+            std::vector<uint32_t> generations;
+            std::vector<unsigned int> freeSlots;
+            Compare compare;
+
+            /// @brief Packs a slot and its current generation into a handle
+            Handle handleOf(unsigned int slot);
+
+            /// @brief Gets the heap index of a handle, throws std::out_of_range if it is not in the heap
+            unsigned int indexOf(Handle handle);
+
+            /// @brief Takes the entry at index out of the heap, filling the hole with the last entry
+            void removeAt(unsigned int index);
+
+            /// @brief Moves the hole at index up until entry fits, then puts entry in it
+            void siftUp(unsigned int index, Entry entry);
+
+            /// @brief Moves the hole at index down until entry fits, then puts entry in it
+            void siftDown(unsigned int index, Entry entry);
+
+            /// @brief Writes entry to heap[index] and records its position
+            void place(unsigned int index, Entry&& entry);
+    };
+}
+
+template <typename Key, unsigned int D, typename Compare>
+unsigned int mystl::IndexedHeap<Key, D, Compare>::size(){
+    return heap.size();
+}
+
+template <typename Key, unsigned int D, typename Compare>
+bool mystl::IndexedHeap<Key, D, Compare>::empty(){
+    return heap.size() == 0;
+}
+
+template <typename Key, unsigned int D, typename Compare>
+typename mystl::IndexedHeap<Key, D, Compare>::Handle mystl::IndexedHeap<Key, D, Compare>::insert(Key key){
+    unsigned int slot;
+    if(!freeSlots.empty()){
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else{
+        slot = position.size();
+        position.push_back(absent);
+        generations.push_back(0);
+    }
+
+    heap.push_back({std::move(key), slot});
+    siftUp(heap.size() - 1, std::move(heap.back()));
+    return handleOf(slot);
+}
+
+template <typename Key, unsigned int D, typename Compare>
+const Key& mystl::IndexedHeap<Key, D, Compare>::top(){
+    if(heap.size() == 0)
+        throw std::out_of_range("Heap is empty");
+    return heap[0].key;
+}
+
+template <typename Key, unsigned int D, typename Compare>
+typename mystl::IndexedHeap<Key, D, Compare>::Handle mystl::IndexedHeap<Key, D, Compare>::topHandle(){
+    if(heap.size() == 0)
+        throw std::out_of_range("Heap is empty");
+    return handleOf(heap[0].slot);
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::pop(){
+    if(heap.size() == 0)
+        throw std::out_of_range("Heap is empty");
+    removeAt(0);
+}
+
+template <typename Key, unsigned int D, typename Compare>
+bool mystl::IndexedHeap<Key, D, Compare>::contains(Handle handle){
+    unsigned int slot = handle & 0xffffffffu;
+    return slot < position.size() && position[slot] != absent && generations[slot] == handle >> 32;
+}
+
+template <typename Key, unsigned int D, typename Compare>
+const Key& mystl::IndexedHeap<Key, D, Compare>::key(Handle handle){
+    return heap[indexOf(handle)].key;
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::increaseKey(Handle handle, Key key){
+    unsigned int index = indexOf(handle);
+    if(compare(key, heap[index].key))
+        throw std::invalid_argument("New key is smaller than the current one");
+    siftUp(index, {std::move(key), heap[index].slot});
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::decreaseKey(Handle handle, Key key){
+    unsigned int index = indexOf(handle);
+    if(compare(heap[index].key, key))
+        throw std::invalid_argument("New key is bigger than the current one");
+    siftDown(index, {std::move(key), heap[index].slot});
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::erase(Handle handle){
+    removeAt(indexOf(handle));
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::clear(){
+    //the slots are all freed rather than forgotten, so handles from before the clear keep being rejected
+    for(unsigned int slot = 0; slot < position.size(); slot++){
+        if(position[slot] != absent){
+            position[slot] = absent;
+            generations[slot]++;
+            freeSlots.push_back(slot);
+        }
+    }
+    heap.clear();
+}
+
+template <typename Key, unsigned int D, typename Compare>
+unsigned int mystl::IndexedHeap<Key, D, Compare>::indexOf(Handle handle){
+    if(!contains(handle))
+        throw std::out_of_range("Invalid handle");
+    return position[handle & 0xffffffffu];
+}
+
+template <typename Key, unsigned int D, typename Compare>
+typename mystl::IndexedHeap<Key, D, Compare>::Handle mystl::IndexedHeap<Key, D, Compare>::handleOf(unsigned int slot){
+    return Handle(generations[slot]) << 32 | slot;
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::removeAt(unsigned int index){
+    unsigned int removed = heap[index].slot;
+    position[removed] = absent;
+    generations[removed]++;
+    freeSlots.push_back(removed);
+
+    Entry last = std::move(heap.back());
+    heap.pop_back();
+    if(index == heap.size())
+        return;
+
+    //the last entry can belong above or below the hole, only one of the sifts moves it
+    if(index > 0 && compare(heap[(index - 1) / D].key, last.key))
+        siftUp(index, std::move(last));
+    else
+        siftDown(index, std::move(last));
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::siftUp(unsigned int index, Entry entry){
+    while(index > 0){
+        unsigned int parent = (index - 1) / D;
+        if(!compare(heap[parent].key, entry.key))
+            break;
+        place(index, std::move(heap[parent]));
+        index = parent;
+    }
+    place(index, std::move(entry));
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::siftDown(unsigned int index, Entry entry){
+    unsigned int size = heap.size();
+    while(true){
+        unsigned int first = index * D + 1;
+        if(first >= size)
+            break;
+
+        //largest of the up to D children
+        unsigned int last = first + D < size ? first + D : size;
+        unsigned int best = first;
+        for(unsigned int child = first + 1; child < last; child++){
+            if(compare(heap[best].key, heap[child].key))
+                best = child;
+        }
+
+        if(!compare(entry.key, heap[best].key))
+            break;
+        place(index, std::move(heap[best]));
+        index = best;
+    }
+    place(index, std::move(entry));
+}
+
+template <typename Key, unsigned int D, typename Compare>
+void mystl::IndexedHeap<Key, D, Compare>::place(unsigned int index, Entry&& entry){
+    position[entry.slot] = index;
+    heap[index] = std::move(entry);
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include "indexedHeap.hpp"
+#include "../check.hpp"
+#include <functional>
+#include <stdexcept>
+
+/// @brief Key without a default constructor, the heap may only copy and move it
+struct Distance{
+    explicit Distance(int _value) : value(_value) {};
+    int value;
+    bool operator<(const Distance& other) const { return value < other.value; }
+};
+
+int main(){
+    //a handle kept after its element left must not reach the element that reuses its slot
+    mystl::IndexedHeap<int> heap;
+    auto stale = heap.insert(7);
+    heap.erase(stale);
+    auto fresh = heap.insert(9);
+    check::that(!heap.contains(stale), "stale handle matched a reused slot");
+    check::that(heap.contains(fresh), "fresh handle not found");
+    check::throws<std::out_of_range>([&]{ heap.decreaseKey(stale, 1); }, "key changed through a stale handle");
+    check::that(heap.key(fresh) == 9, "reused slot changed by a stale handle");
+
+    heap.clear();
+    check::that(!heap.contains(fresh), "handle survived clear");
+    check::that(heap.contains(heap.insert(5)), "handle after clear not found");
+
+    //like the other heaps the top is the largest key by Compare, key changes move the element and top follows them
+    heap.clear();
+    auto a = heap.insert(4);
+    auto b = heap.insert(6);
+    heap.insert(5);
+    check::that(heap.topHandle() == b, "top is not the largest key");
+    heap.increaseKey(a, 9);
+    check::that(heap.topHandle() == a, "increaseKey did not reach the top");
+    heap.decreaseKey(a, 1);
+    check::that(heap.topHandle() == b, "decreaseKey did not leave the top");
+    check::throws<std::invalid_argument>([&]{ heap.decreaseKey(b, 8); }, "decreaseKey accepted a bigger key");
+    check::throws<std::invalid_argument>([&]{ heap.increaseKey(b, 2); }, "increaseKey accepted a smaller key");
+
+    //std::greater turns it into the min heap a shortest path search pops, lowering a distance raises it by Compare
+    mystl::IndexedHeap<int, 4, std::greater<int>> minHeap;
+    auto far = minHeap.insert(10);
+    minHeap.insert(3);
+    minHeap.insert(7);
+    check::throws<std::invalid_argument>([&]{ minHeap.decreaseKey(far, 1); }, "decreaseKey of a min heap moved up");
+    minHeap.increaseKey(far, 1);
+    check::that(minHeap.topHandle() == far, "increaseKey of a min heap did not reach the top");
+    minHeap.pop();
+    check::that(minHeap.top() == 3, "min heap did not pop the smallest key");
+
+    //keys are inserted without default constructing a slot
+    mystl::IndexedHeap<Distance> distances;
+    distances.insert(Distance(4));
+    auto near = distances.insert(Distance(2));
+    distances.increaseKey(near, Distance(6));
+    check::that(distances.topHandle() == near && distances.top().value == 6, "key without default constructor");
+    return check::failures();
+}
@@ -3,7 +3,13 @@
 #include "queue.hpp"
 #include "set.hpp"
 #include "stack.hpp"
+#include "arrayStack.hpp"
 #include "heap.hpp"
+#include "dAryHeap.hpp"
+#include "indexedHeap.hpp"
+#include "multiQueue.hpp"
+#include "pairingHeap.hpp"
+#include "radixHeap.hpp"
 #include "redBlackTree.hpp"
 #include "map.hpp"
 #include "trie.hpp"
\ No newline at end of file
@@ -0,0 +1,161 @@
+#ifndef MULTI_QUEUE
+#define MULTI_QUEUE
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "heap.hpp"
+
+namespace mystl{
+    /// @brief Relaxed concurrent max priority queue made of many small heaps behind their own locks
+    /// Threads never wait on a lock, a busy heap is skipped for another random one, so the queue scales with the
+    /// number of threads at the cost of popping a value that may not be the largest, only close to it on average
+    /// Pop compares the tops of two random heaps and takes the larger, which keeps the rank error O(shards)
+    template <typename T>
+    class MultiQueue{
+        public:
+
+            /// @brief Makes an empty queue
+            /// @param threads Number of threads expected to use it, 0 uses the hardware concurrency
+            /// @param factor Heaps per thread, more lowers contention but raises the rank error
+            explicit MultiQueue(unsigned int threads = 0, unsigned int factor = 2);
+
+            MultiQueue(const MultiQueue&) = delete;
+            MultiQueue& operator=(const MultiQueue&) = delete;
+
+            /// @brief Gets the number of values, only exact while no other thread is changing the queue
+            /// @return Returns size
+            unsigned int size();
+
+            /// @brief Checks if the queue is empty, only exact while no other thread is changing the queue
+            /// @return Return true if queue is empty
+            bool empty();
+
+            /// @brief Gets the number of internal heaps
+            unsigned int shards();
+
+            /// @brief Inserts a value into a random heap that is not locked
+            void push(T data);
+
+            /// @brief Removes the larger top of two random heaps
+            /// @param out Set to the removed value
+            /// @return Returns false if every heap was empty
+            bool tryPop(T& out);
+
+        private:
+            /// @brief One heap and its lock, on its own cache line so threads working on neighbours do not share one
+            struct alignas(64) Shard{
+                std::mutex lock;
+                Heap<T> heap;
+            };
+
+            std::vector<Shard> shardList;
+            std::atomic<unsigned int> count{0};
+
+            /// @brief Picks a random shard with a per thread generator
+            unsigned int randomShard();
+
+            /// @brief Pops from the first shard that has anything, waiting for each lock
+            /// Only used once random picks keep finding empty heaps, so an empty queue is reported truthfully
+            bool popAny(T& out);
+    };
+}
+
+template <typename T>
+mystl::MultiQueue<T>::MultiQueue(unsigned int threads, unsigned int factor)
+    : shardList(std::max(2u, (threads ? threads : std::max(1u, std::thread::hardware_concurrency())) * std::max(1u, factor))) {}
+
+template <typename T>
+unsigned int mystl::MultiQueue<T>::size(){
+    return count.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+bool mystl::MultiQueue<T>::empty(){
+    return size() == 0;
+}
+
+template <typename T>
+unsigned int mystl::MultiQueue<T>::shards(){
+    return shardList.size();
+}
+
+template <typename T>
+void mystl::MultiQueue<T>::push(T data){
+    while(true){
+        Shard& shard = shardList[randomShard()];
+        std::unique_lock<std::mutex> guard(shard.lock, std::try_to_lock);
+        if(!guard.owns_lock())
+            continue;
+        shard.heap.insert(std::move(data));
+        count.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+}
+
+template <typename T>
+bool mystl::MultiQueue<T>::tryPop(T& out){
+    //a few misses in a row on a nearly empty queue fall back to the full scan
+    for(unsigned int attempt = 0; attempt < 2 * shardList.size(); attempt++){
+        unsigned int a = randomShard();
+        unsigned int b = randomShard();
+        if(a == b)
+            continue;
+        std::unique_lock<std::mutex> first(shardList[a].lock, std::try_to_lock);
+        if(!first.owns_lock())
+            continue;
+        std::unique_lock<std::mutex> second(shardList[b].lock, std::try_to_lock);
+        if(!second.owns_lock())
+            continue;
+
+        Heap<T>& left = shardList[a].heap;
+        Heap<T>& right = shardList[b].heap;
+        if(left.empty() && right.empty())
+            continue;
+        Heap<T>& best = right.empty() || (!left.empty() && right.getMax() < left.getMax()) ? left : right;
+        //the other heap is released before the pop so it is held no longer than the comparison
+        if(&best == &left)
+            second.unlock();
+        else
+            first.unlock();
+
+        out = std::move(best.getMax());
+        best.removeMax();
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return popAny(out);
+}
+
+template <typename T>
+unsigned int mystl::MultiQueue<T>::randomShard(){
+    //xorshift, seeded per thread so threads do not walk the shards in step
+    thread_local uint64_t state = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return (unsigned int)(((state >> 32) * shardList.size()) >> 32);
+}
+
+template <typename T>
+bool mystl::MultiQueue<T>::popAny(T& out){
+    unsigned int start = randomShard();
+    for(unsigned int i = 0; i < shardList.size(); i++){
+        Shard& shard = shardList[(start + i) % shardList.size()];
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if(shard.heap.empty())
+            continue;
+        out = std::move(shard.heap.getMax());
+        shard.heap.removeMax();
+        count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef NODE_POOL
+#define NODE_POOL
+
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace mystl{
+    /// @brief Node allocator that goes to new and delete for every node, the default for the linked containers
+    template <typename Node>
+    class NodeAllocator{
+        public:
+            /// @brief Whether release frees nodes that were never destroyed, it can not, so they are destroyed one by one
+            static constexpr bool releasesAll = false;
+
+            /// @brief Allocates and constructs a node
+            template <typename... Args>
+            Node* create(Args&&... args) { return new Node(std::forward<Args>(args)...); };
+
+            /// @brief Destroys and frees a node
+            void destroy(Node* node) { delete node; };
+
+            /// @brief Nothing is held between calls
+            void release() {};
+    };
+
+    /// @brief Node allocator handing out nodes from contiguous slabs, freed nodes are kept on a free list for reuse
+    /// and the slabs are only given back all at once by release or the destructor
+    /// Nodes allocated one after another sit next to each other, and allocating or freeing one is a few pointer moves
+    template <typename Node>
+    class NodePool{
+        public:
+            /// @brief Whether release frees nodes that were never destroyed, their destructors are still not run
+            static constexpr bool releasesAll = true;
+
+            NodePool(){};
+
+            /// @brief Frees every slab
+            ~NodePool();
+
+            NodePool(const NodePool&) = delete;
+            NodePool& operator=(const NodePool&) = delete;
+
+            /// @brief Takes memory for a node, from the free list first, and constructs it
+            template <typename... Args>
+            Node* create(Args&&... args);
+
+            /// @brief Destroys a node and puts its memory on the free list
+            void destroy(Node* node);
+
+            /// @brief Frees every slab at once, nodes still alive are not destroyed and must not be used again
+            void release();
+
+            /// @brief Takes over every slab and free node of other in O(1), nodes other handed out stay valid
+            /// The unused room in other's newest slab is not handed out again until the slabs are released
+            void splice(NodePool& other);
+
+        private:
+            /// @brief Nodes per slab, about a page of them
+            static constexpr size_t slabSize = std::max<size_t>(16, 4096 / sizeof(Node));
+
+            /// @brief Block of nodes, slabs are chained so splice is O(1)
+            struct Slab{
+                Slab* next;
+                alignas(Node) unsigned char storage[slabSize * sizeof(Node)];
+            };
+
+            /// @brief What a freed node's memory holds while it waits to be reused
+            struct FreeSlot{
+                FreeSlot* next;
+            };
+
+            Slab* slabs = nullptr;
+            Slab* lastSlab = nullptr;
+            //nodes of the newest slab handed out so far
+            size_t used = slabSize;
+            FreeSlot* freeList = nullptr;
+            FreeSlot* lastFree = nullptr;
+    };
+}
+
+template <typename Node>
+mystl::NodePool<Node>::~NodePool(){
+    release();
+}
+
+template <typename Node>
+template <typename... Args>
+Node* mystl::NodePool<Node>::create(Args&&... args){
+    void* memory;
+    if(freeList){
+        memory = freeList;
+        freeList = freeList->next;
+        if(!freeList)
+            lastFree = nullptr;
+    }
+    else{
+        if(used == slabSize){
+            Slab* slab = new Slab;
+            slab->next = slabs;
+            slabs = slab;
+            if(!lastSlab)
+                lastSlab = slab;
+            used = 0;
+        }
+        memory = slabs->storage + used++ * sizeof(Node);
+    }
+    return ::new(memory) Node(std::forward<Args>(args)...);
+}
+
+template <typename Node>
+void mystl::NodePool<Node>::destroy(Node* node){
+    std::destroy_at(node);
+    FreeSlot* slot = ::new(static_cast<void*>(node)) FreeSlot{freeList};
+    if(!freeList)
+        lastFree = slot;
+    freeList = slot;
+}
+
+template <typename Node>
+void mystl::NodePool<Node>::release(){
+    while(slabs){
+        Slab* next = slabs->next;
+        delete slabs;
+        slabs = next;
+    }
+    lastSlab = nullptr;
+    used = slabSize;
+    freeList = lastFree = nullptr;
+}
+
+template <typename Node>
+void mystl::NodePool<Node>::splice(NodePool& other){
+    if(&other == this)
+        return;
+    if(other.slabs){
+        if(lastSlab)
+            lastSlab->next = other.slabs;
+        else
+            slabs = other.slabs;
+        lastSlab = other.lastSlab;
+    }
+    if(other.freeList){
+        if(lastFree)
+            lastFree->next = other.freeList;
+        else
+            freeList = other.freeList;
+        lastFree = other.lastFree;
+    }
+    //with no slab of our own, other's newest slab becomes the one being filled
+    if(slabs == other.slabs)
+        used = other.used;
+
+    other.slabs = other.lastSlab = nullptr;
+    other.used = slabSize;
+    other.freeList = other.lastFree = nullptr;
+}
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef PAIRING_HEAP
+#define PAIRING_HEAP
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "nodePool.hpp"
+
+namespace mystl{
+    /// @brief Pairing heap, a max heap of linked nodes that melds two heaps in O(1) and raises a key in O(1)
+    /// Insert and increaseKey are O(1), removeMax and decreaseKey are O(Log(N)) amortized
+    /// Nodes come from a NodePool owned by the heap, a meld splices the other heap's pool in so every handle stays valid
+    /// in the melded heap
+    /// @tparam Compare Less than comparison, std::greater<T> makes it a min heap, keys are raised and lowered in its order
+    template <typename T, typename Compare = std::less<T>>
+    class PairingHeap{
+        private:
+            struct Node{
+                T value;
+                Node* child;
+                Node* sibling;
+                //parent for the first child, left sibling for the rest
+                Node* prev;
+                Node(T&& _value) : value(std::move(_value)), child(nullptr), sibling(nullptr), prev(nullptr) {};
+            };
+
+        public:
+            /// @brief Identifies an element for as long as it is in the heap, including after it is melded into another
+            using Handle = Node*;
+
+            /// @brief Makes an empty heap
+            /// @param _compare Comparison object to order the elements with
+            explicit PairingHeap(const Compare& _compare = Compare()) : compare(_compare) {};
+
+            /// @brief Destroys every element and frees the pool
+            ~PairingHeap();
+
+            PairingHeap(const PairingHeap&) = delete;
+            PairingHeap& operator=(const PairingHeap&) = delete;
+
+            /// @brief Gets size of heap
+            /// @return Returns size
+            unsigned int size();
+
+            /// @brief Checks if the heap is empty
+            /// @return Return true if heap is empty
+            bool empty();
+
+            /// @brief Insert new value in heap
+            /// @return Returns the handle of the new element
+            Handle insert(T data);
+
+            /// @brief Gets the largest value by Compare
+            /// @return Reference to the largest value
+            T& getMax();
+
+            /// @brief Removes the largest value, its handle becomes invalid
+            void removeMax();
+
+            /// @brief Moves every element of other into this heap in O(1), other is left empty
+            void meld(PairingHeap& other);
+
+            /// @brief Gets the value of an element
+            const T& key(Handle handle);
+
+            /// @brief Raises the value of an element, cutting it out and linking it with the root
+            /// @param data New value, throws std::invalid_argument if it is smaller than the current one
+            void increaseKey(Handle handle, T data);
+
+            /// @brief Lowers the value of an element, its children are paired and melded back in
+            /// @param data New value, throws std::invalid_argument if it is bigger than the current one
+            void decreaseKey(Handle handle, T data);
+
+            /// @brief Removes an element, its handle becomes invalid
+            void erase(Handle handle);
+
+            /// @brief Clears the heap, frees the pool and resets to size 0
+            void clear();
+
+        private:
+            Node* root = nullptr;
+            unsigned int _size = 0;
+            Compare compare;
+            NodePool<Node> nodes;
+
+            /// @brief Makes the root that compares larger the parent of the other, either may be null
+            Node* link(Node* a, Node* b);
+
+            /// @brief Takes the node out of its parent's child list, it must not be the root
+            void cut(Node* node);
+
+            /// @brief Two pass pairing of a sibling list into one tree, left to right in pairs then right to left
+            Node* combineSiblings(Node* first);
+
+            /// @brief Destroys every element still in the heap
+            void destroyNodes();
+    };
+}
+
+template <typename T, typename Compare>
+mystl::PairingHeap<T, Compare>::~PairingHeap(){
+    clear();
+}
+
+template <typename T, typename Compare>
+unsigned int mystl::PairingHeap<T, Compare>::size(){
+    return _size;
+}
+
+template <typename T, typename Compare>
+bool mystl::PairingHeap<T, Compare>::empty(){
+    return _size == 0;
+}
+
+template <typename T, typename Compare>
+typename mystl::PairingHeap<T, Compare>::Handle mystl::PairingHeap<T, Compare>::insert(T data){
+    Node* node = nodes.create(std::move(data));
+    root = link(root, node);
+    _size++;
+    return node;
+}
+
+template <typename T, typename Compare>
+T& mystl::PairingHeap<T, Compare>::getMax(){
+    if(_size == 0)
+        throw std::out_of_range("Heap is empty");
+    return root->value;
+}
+
+template <typename T, typename Compare>
+void mystl::PairingHeap<T, Compare>::removeMax(){
+    if(_size == 0)
+        throw std::out_of_range("Heap is empty");
+    Node* old = root;
+    root = combineSiblings(root->child);
+    nodes.destroy(old);
+    _size--;
+}
+
+template <typename T, typename Compare>
+void mystl::PairingHeap<T, Compare>::meld(PairingHeap& other){
+    if(&other == this)
+        return;
+    root = link(root, other.root);
+    _size += other._size;
+    //the nodes stay where their handles point, only who frees them changes
+    nodes.splice(other.nodes);
+    other.root = nullptr;
+    other._size = 0;
+}
+
+template <typename T, typename Compare>
+const T& mystl::PairingHeap<T, Compare>::key(Handle handle){
+    return handle->value;
+}
+
+template <typename T, typename Compare>
+void mystl::PairingHeap<T, Compare>::increaseKey(Handle handle, T data){
+    if(compare(data, handle->value))
+        throw std::invalid_argument("New key is smaller than the current one");
+    handle->value = std::move(data);
+    if(handle == root)
+        return;
+    //the subtree under the node is still a heap, only its link to the parent can be wrong
+    cut(handle);
+    root = link(root, handle);
+}
+
+template <typename T, typename Compare>
+void mystl::PairingHeap<T, Compare>::decreaseKey(Handle handle, T data){
+    if(compare(handle->value, data))
+        throw std::invalid_argument("New key is bigger than the current one");
+    handle->value = std::move(data);
+    Node* children = combineSiblings(handle->child);
+    handle->child = nullptr;
+    if(handle == root){
+        root = link(handle, children);
+        return;
+    }
+    cut(handle);
+    root = link(link(root, children), handle);
+}
+
+template <typename T, typename Compare>
+void mystl::PairingHeap<T, Compare>::erase(Handle handle){
+    if(handle == root){
+        removeMax();
+        return;
+    }
+    cut(handle);
+    root = link(root, combineSiblings(handle->child));
+    nodes.destroy(handle);
+    _size--;
+}
+
+template <typename T, typename Compare>
+void mystl::PairingHeap<T, Compare>::clear(){
+    destroyNodes();
+    nodes.release();
+    root = nullptr;
+    _size = 0;
+}
+
+template <typename T, typename Compare>
+typename mystl::PairingHeap<T, Compare>::Node* mystl::PairingHeap<T, Compare>::link(Node* a, Node* b){
+    if(!a)
+        return b;
+    if(!b)
+        return a;
+    if(compare(a->value, b->value))
+        std::swap(a, b);
+    //b becomes the first child of a
+    b->sibling = a->child;
+    if(a->child)
+        a->child->prev = b;
+    b->prev = a;
+    a->child = b;
+    a->sibling = nullptr;
+    a->prev = nullptr;
+    return a;
+}
+
+template <typename T, typename Compare>
+void mystl::PairingHeap<T, Compare>::cut(Node* node){
+    if(node->prev->child == node)
+        node->prev->child = node->sibling;
+    else
+        node->prev->sibling = node->sibling;
+    if(node->sibling)
+        node->sibling->prev = node->prev;
+    node->sibling = nullptr;
+    node->prev = nullptr;
+}
+
+template <typename T, typename Compare>
+typename mystl::PairingHeap<T, Compare>::Node* mystl::PairingHeap<T, Compare>::combineSiblings(Node* first){
+    //first pass links neighbours in pairs, the results are pushed on a stack threaded through sibling
+    Node* paired = nullptr;
+    while(first){
+        Node* a = first;
+        Node* b = a->sibling;
+        first = b ? b->sibling : nullptr;
+        Node* winner = b ? link(a, b) : a;
+        winner->sibling = paired;
+        paired = winner;
+    }
+    if(!paired)
+        return nullptr;
+
+    //second pass melds them from the last pair back to the first
+    Node* result = paired;
+    paired = paired->sibling;
+    result->sibling = nullptr;
+    while(paired){
+        Node* next = paired->sibling;
+        result = link(result, paired);
+        paired = next;
+    }
+    result->prev = nullptr;
+    return result;
+}
+
+template <typename T, typename Compare>
+void mystl::PairingHeap<T, Compare>::destroyNodes(){
+    if constexpr(std::is_trivially_destructible_v<T>){
+        return;
+    }
+    else{
+        //children are spliced onto the list being walked, so no stack is needed however deep the tree is
+        Node* pending = root;
+        while(pending){
+            Node* node = pending;
+            pending = node->sibling;
+            if(node->child){
+                Node* last = node->child;
+                while(last->sibling)
+                    last = last->sibling;
+                last->sibling = pending;
+                pending = node->child;
+            }
+            std::destroy_at(node);
+        }
+    }
+}
+
+#endif
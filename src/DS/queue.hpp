@@ -6,7 +6,8 @@
 
 namespace mystl{
     /// @brief Container with First in First out behavior
-    template <typename T>
+    /// @tparam Allocator Where the list gets its nodes from, NodePool keeps them in contiguous slabs
+    template <typename T, template <typename> class Allocator = NodeAllocator>
     class Queue{
         public:
 
@@ -39,47 +40,47 @@ namespace mystl{
             bool empty();
             
         private:
-            mystl::SinglyLinkedList<T>* list;
+            mystl::SinglyLinkedList<T, Allocator>* list;
     };
 }
 
-template <typename T>
-mystl::Queue<T>::Queue(){
-    list = new SinglyLinkedList<T>();
+template <typename T, template <typename> class Allocator>
+mystl::Queue<T, Allocator>::Queue(){
+    list = new SinglyLinkedList<T, Allocator>();
 }
 
-template <typename T>
-mystl::Queue<T>::~Queue(){
+template <typename T, template <typename> class Allocator>
+mystl::Queue<T, Allocator>::~Queue(){
     delete list;
 }
 
-template <typename T>
-unsigned int mystl::Queue<T>::size(){
+template <typename T, template <typename> class Allocator>
+unsigned int mystl::Queue<T, Allocator>::size(){
     return list->size();
 }
 
-template <typename T>
-void mystl::Queue<T>::pop(){
+template <typename T, template <typename> class Allocator>
+void mystl::Queue<T, Allocator>::pop(){
     list->removeAt(0);
 }
 
-template <typename T>
-void mystl::Queue<T>::push(T data){
+template <typename T, template <typename> class Allocator>
+void mystl::Queue<T, Allocator>::push(T data){
     list->push_back(data);
 }
 
-template <typename T>
-T& mystl::Queue<T>::front(){
+template <typename T, template <typename> class Allocator>
+T& mystl::Queue<T, Allocator>::front(){
     return (*list)[0];
 }
 
-template <typename T>
-T& mystl::Queue<T>::back(){
+template <typename T, template <typename> class Allocator>
+T& mystl::Queue<T, Allocator>::back(){
     return (*list)[list->size()-1];
 }
 
-template <typename T>
-bool mystl::Queue<T>::empty(){
+template <typename T, template <typename> class Allocator>
+bool mystl::Queue<T, Allocator>::empty(){
     return list->size() == 0;
 }
 
@@ -0,0 +1,169 @@
+#ifndef RADIX_HEAP
+#define RADIX_HEAP
+
+#include <bit>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mystl{
+    /// @brief Min heap for unsigned integer keys that are never smaller than the last one popped, as in Dijkstra with
+    /// integer weights or an event simulation
+    /// Elements are kept in buckets by the highest bit where their key differs from the last popped key, an element
+    /// only moves to a lower bucket, so every operation is O(Log(C)) amortized for keys up to C without comparisons
+    /// @tparam T Unsigned integer key, or a std::pair whose first member is the unsigned key and second is carried along
+    template <typename T>
+    class RadixHeap{
+        private:
+            static auto keyOf(const T& value){
+                if constexpr(std::is_integral_v<T>)
+                    return value;
+                else
+                    return value.first;
+            }
+
+        public:
+            using Key = decltype(keyOf(std::declval<T>()));
+            static_assert(std::is_unsigned_v<Key>, "RadixHeap keys have to be unsigned integers");
+
+            /// @brief Gets size of heap
+            /// @return Returns size
+            unsigned int size();
+
+            /// @brief Checks if the heap is empty
+            /// @return Return true if heap is empty
+            bool empty();
+
+            /// @brief Insert new value in heap
+            /// @param data Value whose key is at least the last popped key, throws std::invalid_argument otherwise
+            void insert(T data);
+
+            /// @brief Gets the value with the smallest key without changing what can still be inserted
+            /// @return Reference to the top value, valid until the next insert or pop
+            const T& top();
+
+            /// @brief Removes the value with the smallest key, later inserts can not go below its key
+            void pop();
+
+            /// @brief Clears the heap, resets to size 0 and lets keys start from 0 again
+            void clear();
+
+        private:
+            static constexpr unsigned int bits = std::numeric_limits<Key>::digits;
+
+            //bucket 0 holds keys equal to last, bucket b keys whose highest bit differing from last is b-1
+            std::vector<T> buckets[bits + 1];
+            Key last = 0;
+            unsigned int _size = 0;
+            //top found by the last peek, so peeking again does not scan the bucket again
+            const T* peeked = nullptr;
+
+            /// @brief Gets the bucket a key belongs in relative to last
+            unsigned int bucketOf(Key key);
+
+            /// @brief Gets the lowest non empty bucket, the heap must not be empty
+            unsigned int firstBucket();
+
+            /// @brief Gets the index of the smallest key in a bucket
+            size_t smallestIn(unsigned int b);
+
+            /// @brief Makes bucket 0 hold the smallest keys, moving last up to the smallest key of the first
+            /// non empty bucket and spreading that bucket over the lower ones
+            void refill();
+    };
+}
+
+template <typename T>
+unsigned int mystl::RadixHeap<T>::size(){
+    return _size;
+}
+
+template <typename T>
+bool mystl::RadixHeap<T>::empty(){
+    return _size == 0;
+}
+
+template <typename T>
+void mystl::RadixHeap<T>::insert(T data){
+    Key key = keyOf(data);
+    if(key < last)
+        throw std::invalid_argument("Key is smaller than the last popped key");
+    buckets[bucketOf(key)].push_back(std::move(data));
+    _size++;
+    peeked = nullptr;
+}
+
+template <typename T>
+const T& mystl::RadixHeap<T>::top(){
+    if(_size == 0)
+        throw std::out_of_range("Heap is empty");
+    //last only moves on pop, a peek that raised it would make inserting keys between the popped one and the top fail
+    if(!peeked){
+        unsigned int b = firstBucket();
+        peeked = b == 0 ? &buckets[0].back() : &buckets[b][smallestIn(b)];
+    }
+    return *peeked;
+}
+
+template <typename T>
+void mystl::RadixHeap<T>::pop(){
+    if(_size == 0)
+        throw std::out_of_range("Heap is empty");
+    refill();
+    buckets[0].pop_back();
+    _size--;
+    peeked = nullptr;
+}
+
+template <typename T>
+void mystl::RadixHeap<T>::clear(){
+    for(std::vector<T>& bucket : buckets)
+        bucket.clear();
+    last = 0;
+    _size = 0;
+    peeked = nullptr;
+}
+
+template <typename T>
+unsigned int mystl::RadixHeap<T>::bucketOf(Key key){
+    return std::bit_width(Key(key ^ last));
+}
+
+template <typename T>
+unsigned int mystl::RadixHeap<T>::firstBucket(){
+    unsigned int b = 0;
+    while(buckets[b].empty())
+        b++;
+    return b;
+}
+
+template <typename T>
+size_t mystl::RadixHeap<T>::smallestIn(unsigned int b){
+    size_t smallest = 0;
+    for(size_t i = 1; i < buckets[b].size(); i++){
+        if(keyOf(buckets[b][i]) < keyOf(buckets[b][smallest]))
+            smallest = i;
+    }
+    return smallest;
+}
+
+template <typename T>
+void mystl::RadixHeap<T>::refill(){
+    if(!buckets[0].empty())
+        return;
+    unsigned int b = firstBucket();
+    last = keyOf(buckets[b][smallestIn(b)]);
+
+    //every key in bucket b now differs from last below bit b-1, so each lands in a lower bucket
+    std::vector<T> moving;
+    moving.swap(buckets[b]);
+    for(T& value : moving)
+        buckets[bucketOf(keyOf(value))].push_back(std::move(value));
+    //the emptied storage goes back to the bucket so it is not allocated again
+    moving.clear();
+    buckets[b].swap(moving);
+}
+
+#endif
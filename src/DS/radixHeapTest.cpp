@@ -0,0 +1,31 @@
+#include "radixHeap.hpp"
+#include "../check.hpp"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+int main(){
+    //peeking must not raise the floor for later inserts, only popping does
+    mystl::RadixHeap<unsigned int> heap;
+    heap.insert(10);
+    check::that(heap.top() == 10, "top on a fresh heap");
+    heap.insert(3);
+    heap.insert(5);
+    heap.pop();
+    check::that(heap.top() == 5, "top after pop");
+    heap.insert(4);
+    check::that(heap.top() == 4, "insert between the popped key and the top");
+    check::throws<std::invalid_argument>([&]{ heap.insert(2); }, "key below the popped one accepted");
+
+    //values ride along with their keys and come out in key order
+    mystl::RadixHeap<std::pair<unsigned long, char>> pairs;
+    for(auto [key, value] : {std::pair{7ul, 'c'}, {1ul, 'a'}, {4ul, 'b'}})
+        pairs.insert({key, value});
+    std::string order;
+    while(!pairs.empty()){
+        order += pairs.top().second;
+        pairs.pop();
+    }
+    check::that(order == "abc", "pairs pop in key order");
+    return check::failures();
+}
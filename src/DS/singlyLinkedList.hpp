@@ -2,10 +2,13 @@
 #define SINGLY_LINKED_LIST
 
 #include <iostream>
+#include <type_traits>
+#include "nodePool.hpp"
 
 namespace mystl{
     /// @brief Singly Linked List with head and tail pointers
-    template <class T> 
+    /// @tparam Allocator Where the nodes come from, NodePool keeps them in contiguous slabs instead of one new per node
+    template <class T, template <typename> class Allocator = NodeAllocator>
     class SinglyLinkedList{
         public:
             /// @brief Default constructor
@@ -56,7 +59,7 @@ namespace mystl{
             /// @return new List
             SinglyLinkedList(const SinglyLinkedList& RHS);
 
-            /// @brief clears all data from the list and resets size to 0
+            /// @brief clears all data from the list, gives the nodes back to the allocator and resets size to 0
             void clear();
 
             /// @brief Returns the value at the given position if valid, otherwise throws error
@@ -68,6 +71,10 @@ namespace mystl{
             /// @return 
             bool empty();
 
+            /// @brief Stable bottom up merge sort that relinks the nodes, O(N*Log(N)) time and O(1) extra space
+            /// No node is allocated and no value is copied
+            void sort();
+
 
         private:
             struct Node{
@@ -78,30 +85,40 @@ namespace mystl{
             unsigned int _size = 0;
             Node* head = nullptr;
             Node* tail = nullptr;
+            Allocator<Node> nodes;
+
+            /// @brief Cuts the list after count nodes
+            /// @return Returns the node after the cut, nullptr if the list was not longer than count
+            static Node* split(Node* first, unsigned int count);
+
+            /// @brief Merges two sorted lists, equal values keep left first
+            /// @param last Set to the last node of the merged list
+            /// @return Returns the head of the merged list
+            static Node* merge(Node* left, Node* right, Node*& last);
     };
 }
 
-template<typename T>
-unsigned int mystl::SinglyLinkedList<T>::size(){
+template<typename T, template <typename> class Allocator>
+unsigned int mystl::SinglyLinkedList<T, Allocator>::size(){
     return this->_size;
 }
 
-template<typename T>
-void mystl::SinglyLinkedList<T>::push_front(T data){
+template<typename T, template <typename> class Allocator>
+void mystl::SinglyLinkedList<T, Allocator>::push_front(T data){
     this->_size++;
     if(head){
-        Node* newHead = new Node(data);
+        Node* newHead = nodes.create(data);
         newHead->next = this->head;
         this->head = newHead;
     }
     else{
-        Node* head = new Node(data);
+        Node* head = nodes.create(data);
         this->head = head;
     }
 }
 
-template<typename T>
-void mystl::SinglyLinkedList<T>::push_back(T data){
+template<typename T, template <typename> class Allocator>
+void mystl::SinglyLinkedList<T, Allocator>::push_back(T data){
     if(!head){
         push_front(data);
         this->tail = this->head;
@@ -109,14 +126,14 @@ void mystl::SinglyLinkedList<T>::push_back(T data){
     }
 
     this->_size++;
-    Node* newTail = new Node(data);
+    Node* newTail = nodes.create(data);
     tail->next = newTail;
     tail = newTail;
     return;
 }
 
-template<typename T>
-void mystl::SinglyLinkedList<T>::insert(T data, unsigned int pos){
+template<typename T, template <typename> class Allocator>
+void mystl::SinglyLinkedList<T, Allocator>::insert(T data, unsigned int pos){
     if(pos == 0){
         push_front(data);
         return;
@@ -133,7 +150,7 @@ void mystl::SinglyLinkedList<T>::insert(T data, unsigned int pos){
     for(unsigned int i = 0; i < pos-1; i++){
         temp = temp->next;
     }
-    Node* newNode = new Node(data);
+    Node* newNode = nodes.create(data);
     Node* newNext = temp->next;
     temp->next = newNode;
     newNode->next = newNext;
@@ -141,13 +158,13 @@ void mystl::SinglyLinkedList<T>::insert(T data, unsigned int pos){
 }
 
 
-template<typename T>
-mystl::SinglyLinkedList<T>::~SinglyLinkedList(){
+template<typename T, template <typename> class Allocator>
+mystl::SinglyLinkedList<T, Allocator>::~SinglyLinkedList(){
     clear();
 }
 
-template<typename T>
-void mystl::SinglyLinkedList<T>::printList(){
+template<typename T, template <typename> class Allocator>
+void mystl::SinglyLinkedList<T, Allocator>::printList(){
     Node* temp = head;
     while(temp){
         std::cout << temp->data << " ";
@@ -156,8 +173,8 @@ void mystl::SinglyLinkedList<T>::printList(){
     std::cout << "\n";
 }
 
-template<typename T>
-void mystl::SinglyLinkedList<T>::removeAt(unsigned int pos){
+template<typename T, template <typename> class Allocator>
+void mystl::SinglyLinkedList<T, Allocator>::removeAt(unsigned int pos){
     if(pos >= this->_size || this->_size == 0)
         throw std::out_of_range("Invalid index");
     this->_size--;
@@ -166,7 +183,7 @@ void mystl::SinglyLinkedList<T>::removeAt(unsigned int pos){
         temp = temp->next;
         Node* currHead = head;
         head = temp;
-        delete currHead;
+        nodes.destroy(currHead);
         return;
     }
 
@@ -174,15 +191,15 @@ void mystl::SinglyLinkedList<T>::removeAt(unsigned int pos){
         temp = temp->next;
     }
     Node* newNext = temp->next->next;
-    delete temp->next;
+    nodes.destroy(temp->next);
     temp->next = newNext;
     if(!newNext){
         this->tail = temp;
     }
 }
 
-template <typename T>
-bool mystl::SinglyLinkedList<T>::search(T data){
+template <typename T, template <typename> class Allocator>
+bool mystl::SinglyLinkedList<T, Allocator>::search(T data){
     Node* temp = head;
     while(temp){
         if(temp->data == data)
@@ -192,13 +209,13 @@ bool mystl::SinglyLinkedList<T>::search(T data){
     return false;
 }
 
-template <typename T>
-T mystl::SinglyLinkedList<T>::at(unsigned int pos){
+template <typename T, template <typename> class Allocator>
+T mystl::SinglyLinkedList<T, Allocator>::at(unsigned int pos){
     return T(operator[](pos));
 }
 
-template <typename T>
-T& mystl::SinglyLinkedList<T>::operator[](unsigned int pos){
+template <typename T, template <typename> class Allocator>
+T& mystl::SinglyLinkedList<T, Allocator>::operator[](unsigned int pos){
     if(pos >= this->_size)
         throw std::out_of_range("Invalid index");
     Node* temp = head;
@@ -208,19 +225,23 @@ T& mystl::SinglyLinkedList<T>::operator[](unsigned int pos){
     return temp->data;
 }
 
-template <typename T>
-mystl::SinglyLinkedList<T>& mystl::SinglyLinkedList<T>::operator=(const mystl::SinglyLinkedList<T>& RHS){
+template <typename T, template <typename> class Allocator>
+mystl::SinglyLinkedList<T, Allocator>& mystl::SinglyLinkedList<T, Allocator>::operator=(const mystl::SinglyLinkedList<T, Allocator>& RHS){
+    if(this == &RHS)
+        return (*this);
+    //the old nodes go back to our own allocator before the copy is made
+    clear();
     this->_size = RHS._size;
     Node* oldTemp = RHS.head;
     this->head = nullptr;
     this->tail = nullptr;
     if(this->_size == 0)
         return (*this);
-    Node* newHead = new Node(oldTemp->data);
+    Node* newHead = nodes.create(oldTemp->data);
     Node* temp = newHead;
     oldTemp = oldTemp->next;
     while(oldTemp){
-        Node* curr = new Node(oldTemp->data);
+        Node* curr = nodes.create(oldTemp->data);
         temp->next = curr;
         oldTemp = oldTemp->next;
         temp = curr;
@@ -230,18 +251,18 @@ mystl::SinglyLinkedList<T>& mystl::SinglyLinkedList<T>::operator=(const mystl::S
     return (*this);
 }
 
-template <typename T>
-mystl::SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList<T>& RHS){
+template <typename T, template <typename> class Allocator>
+mystl::SinglyLinkedList<T, Allocator>::SinglyLinkedList(const SinglyLinkedList<T, Allocator>& RHS){
     this->_size = RHS._size;
     Node* oldTemp = RHS.head;
     this->head = nullptr;
     if(this->_size == 0)
         return;
-    Node* newHead = new Node(oldTemp->data);
+    Node* newHead = nodes.create(oldTemp->data);
     Node* temp = newHead;
     oldTemp = oldTemp->next;
     while(oldTemp){
-        Node* curr = new Node(oldTemp->data);
+        Node* curr = nodes.create(oldTemp->data);
         temp->next = curr;
         oldTemp = oldTemp->next;
         temp = curr;
@@ -250,24 +271,100 @@ mystl::SinglyLinkedList<T>::SinglyLinkedList(const SinglyLinkedList<T>& RHS){
     this->head = newHead;
 }
 
-template <typename T>
-void mystl::SinglyLinkedList<T>::clear(){
-    if(!head)
-        return;
-    
-    Node* temp = head;
-    while (temp) {
-        Node* next = temp->next;
-        delete temp;
-        temp = next;
+template <typename T, template <typename> class Allocator>
+void mystl::SinglyLinkedList<T, Allocator>::clear(){
+    //a pool frees nodes that need no destructor together with its slabs, the list does not have to be walked
+    if constexpr(!Allocator<Node>::releasesAll || !std::is_trivially_destructible_v<T>){
+        Node* temp = head;
+        while (temp) {
+            Node* next = temp->next;
+            nodes.destroy(temp);
+            temp = next;
+        }
     }
+    nodes.release();
     this->head = nullptr;
     this->tail = nullptr;
+    this->_size = 0;
 }
 
-template <typename T>
-bool mystl::SinglyLinkedList<T>::empty(){
+template <typename T, template <typename> class Allocator>
+bool mystl::SinglyLinkedList<T, Allocator>::empty(){
     return this->_size == 0;
 }
 
+template <typename T, template <typename> class Allocator>
+void mystl::SinglyLinkedList<T, Allocator>::sort(){
+    if(this->_size < 2)
+        return;
+
+    //every pass merges neighbouring sorted runs of width nodes into runs of 2*width
+    for(unsigned int width = 1; width < this->_size; width *= 2){
+        Node* rest = this->head;
+        Node* sortedTail = nullptr;
+        this->head = nullptr;
+        while(rest){
+            Node* left = rest;
+            Node* right = split(left, width);
+            rest = split(right, width);
+
+            Node* last;
+            Node* merged = merge(left, right, last);
+            if(sortedTail)
+                sortedTail->next = merged;
+            else
+                this->head = merged;
+            sortedTail = last;
+        }
+        this->tail = sortedTail;
+    }
+}
+
+template <typename T, template <typename> class Allocator>
+typename mystl::SinglyLinkedList<T, Allocator>::Node* mystl::SinglyLinkedList<T, Allocator>::split(Node* first, unsigned int count){
+    for(unsigned int i = 1; first && i < count; i++){
+        first = first->next;
+    }
+    if(!first)
+        return nullptr;
+    Node* rest = first->next;
+    first->next = nullptr;
+    return rest;
+}
+
+template <typename T, template <typename> class Allocator>
+typename mystl::SinglyLinkedList<T, Allocator>::Node* mystl::SinglyLinkedList<T, Allocator>::merge(Node* left, Node* right, Node*& last){
+    Node* merged = nullptr;
+    Node* curr = nullptr;
+    while(left || right){
+        //right only goes first when strictly smaller, which keeps the sort stable
+        Node* next;
+        if(!left || (right && right->data < left->data)){
+            next = right;
+            right = right->next;
+        }
+        else{
+            next = left;
+            left = left->next;
+        }
+
+        if(curr)
+            curr->next = next;
+        else
+            merged = next;
+        curr = next;
+
+        //once one side runs out the other is already linked, only its last node is needed
+        if(!left || !right){
+            Node* remaining = left ? left : right;
+            curr->next = remaining;
+            while(curr->next)
+                curr = curr->next;
+            break;
+        }
+    }
+    last = curr;
+    return merged;
+}
+
 #endif
\ No newline at end of file
@@ -5,8 +5,10 @@
 #include "singlyLinkedList.hpp"
 
 namespace mystl{
-    /// @brief First in Last out container implementation
-    template <typename T>
+    /// @brief First in Last out container implementation, the top is the head of the list so every operation is O(1)
+    /// ArrayStack keeps the elements contiguous instead, which is faster when no node has to outlive a pop
+    /// @tparam Allocator Where the list gets its nodes from, NodePool keeps them in contiguous slabs
+    template <typename T, template <typename> class Allocator = NodeAllocator>
     class Stack{
         public:
 
@@ -20,10 +22,10 @@ namespace mystl{
             /// @return Returns the size
             unsigned int size();
 
-            /// @brief Removes the first element
+            /// @brief Removes the top element
             void pop();
 
-            /// @brief Insert element at the end
+            /// @brief Insert element on top
             void push(T data);
             
             /// @brief Access the top of the stack
@@ -36,45 +38,45 @@ namespace mystl{
             bool empty();
             
         private:
-            SinglyLinkedList<T>* list;
+            SinglyLinkedList<T, Allocator>* list;
     };
 }
 
-template <typename T>
-mystl::Stack<T>::Stack(){
-    list = new SinglyLinkedList<T>();
+template <typename T, template <typename> class Allocator>
+mystl::Stack<T, Allocator>::Stack(){
+    list = new SinglyLinkedList<T, Allocator>();
 }
 
-template <typename T>
-mystl::Stack<T>::~Stack(){
+template <typename T, template <typename> class Allocator>
+mystl::Stack<T, Allocator>::~Stack(){
     delete list;
 }
 
-template <typename T>
-unsigned int mystl::Stack<T>::size(){
+template <typename T, template <typename> class Allocator>
+unsigned int mystl::Stack<T, Allocator>::size(){
     return list->size();
 }
 
-template <typename T>
-void mystl::Stack<T>::pop(){
+template <typename T, template <typename> class Allocator>
+void mystl::Stack<T, Allocator>::pop(){
     if(list->size() > 0)
-        list->removeAt(list->size() - 1);
+        list->removeAt(0);
     else
         throw std::out_of_range("Stack is empty");
 }
 
-template <typename T>
-void mystl::Stack<T>::push(T data){
-    list->push_back(data);
+template <typename T, template <typename> class Allocator>
+void mystl::Stack<T, Allocator>::push(T data){
+    list->push_front(data);
 }
 
-template <typename T>
-T& mystl::Stack<T>::top(){
-    return (*list)[list->size() - 1];
+template <typename T, template <typename> class Allocator>
+T& mystl::Stack<T, Allocator>::top(){
+    return (*list)[0];
 }
 
-template <typename T>
-bool mystl::Stack<T>::empty(){
+template <typename T, template <typename> class Allocator>
+bool mystl::Stack<T, Allocator>::empty(){
     return list->size() == 0;
 }
 
@@ -0,0 +1,36 @@
+#ifndef TEST_CHECK
+#define TEST_CHECK
+
+#include <iostream>
+
+/// @brief Minimal checks for the tests beside each header, a test's main returns failures() as its exit code
+namespace check{
+    inline int failed = 0;
+
+    /// @brief Reports what when the condition does not hold
+    inline void that(bool condition, const char* what){
+        if(!condition){
+            std::cerr << "failed: " << what << "\n";
+            failed++;
+        }
+    }
+
+    /// @brief Reports what unless calling action throws an Exception
+    template <typename Exception, typename Action>
+    void throws(Action action, const char* what){
+        try{
+            action();
+        }
+        catch(const Exception&){
+            return;
+        }
+        that(false, what);
+    }
+
+    /// @brief Exit code of the test, 1 if any check failed
+    inline int failures(){
+        return failed != 0;
+    }
+}
+
+#endif